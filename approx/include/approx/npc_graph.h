@@ -1,14 +1,20 @@
 #ifndef APPROX_GRAPH_H
 #define APPROX_GRAPH_H
 
+#include <algorithm>
+#include <iterator>
 #include <list>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <graph/bipartite.h>
 
 #include <structures/graph.h>
 #include <structures/heap>
 
+#include <util/exposed_graph.h>
+
 namespace approx {
 
 // NPC problem: Vertex Cover
@@ -90,6 +96,105 @@ std::list<Vertex> vertex_cover_edge_double(
     return result;
 }
 
+// NPC problem: Vertex Cover
+// Both endpoints of a maximal matching, built greedily in one pass over a stream of edges
+// (u, v) on dense ids 0 - (n - 1); a self-loop puts its vertex in the cover
+// Provides a vertex cover of size <= 2 * optimal, using n bits besides the stream
+// Θ(V+E)
+template <typename InputIt>
+std::vector<std::size_t> vertex_cover_maximal_matching(std::size_t n, InputIt first, InputIt last)
+{
+    std::vector<bool> in_cover(n, false);
+    for (; first != last; ++first) {
+        std::size_t u = first->first, v = first->second;
+        if (!in_cover[u] && !in_cover[v])
+            in_cover[u] = in_cover[v] = true;
+    }
+
+    std::vector<std::size_t> result;
+    for (std::size_t v = 0; v < n; ++v)
+        if (in_cover[v])
+            result.push_back(v);
+    return result;
+}
+
+// On an undirected graph in CSR form, reading each edge in its first direction only
+template <typename EdgeWeight>
+std::vector<std::size_t> vertex_cover_maximal_matching(const util::csr_graph<EdgeWeight>& input)
+{
+    std::vector<bool> in_cover(input.order(), false);
+    for (std::size_t u = 0; u < input.order(); ++u)
+        for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1] && !in_cover[u]; ++j) {
+            std::size_t v = input.targets[j];
+            if (v >= u && !in_cover[v])
+                in_cover[u] = in_cover[v] = true;
+        }
+
+    std::vector<std::size_t> result;
+    for (std::size_t v = 0; v < input.order(); ++v)
+        if (in_cover[v])
+            result.push_back(v);
+    return result;
+}
+
+// NPC problem: Weighted Vertex Cover
+// Local ratio: every edge (u, v) of the stream whose endpoints both have residual weight left
+// lowers both by the smaller residual; the vertices brought to 0 form the cover
+// Provides a vertex cover of weight <= 2 * optimal, using a residual weight per vertex besides the
+// stream; weights must be non-negative
+// Reuven Bar-Yehuda and Shimon Even (1985)
+// Θ(V+E)
+template <typename Weight, typename InputIt>
+std::vector<std::size_t> weighted_vertex_cover_local_ratio(
+    const std::vector<Weight>& weight, InputIt first, InputIt last)
+{
+    std::vector<Weight> residual(weight);
+    for (; first != last; ++first) {
+        std::size_t u = first->first, v = first->second;
+        if (u == v) {
+            residual[u] = Weight();
+        } else if (Weight() < residual[u] && Weight() < residual[v]) {
+            Weight paid = std::min(residual[u], residual[v]);
+            residual[u] -= paid;
+            residual[v] -= paid;
+        }
+    }
+
+    std::vector<std::size_t> result;
+    for (std::size_t v = 0; v < residual.size(); ++v)
+        if (!(Weight() < residual[v]))
+            result.push_back(v);
+    return result;
+}
+
+// On an undirected graph in CSR form with a weight per vertex, reading each edge in its first
+// direction only
+template <typename EdgeWeight, typename Weight>
+std::vector<std::size_t> weighted_vertex_cover_local_ratio(
+    const util::csr_graph<EdgeWeight>& input, const std::vector<Weight>& weight)
+{
+    std::vector<Weight> residual(weight);
+    for (std::size_t u = 0; u < input.order(); ++u)
+        for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j) {
+            std::size_t v = input.targets[j];
+            if (v < u || !(Weight() < residual[u]))
+                continue;
+            if (u == v) {
+                residual[u] = Weight();
+            } else if (Weight() < residual[v]) {
+                Weight paid = std::min(residual[u], residual[v]);
+                residual[u] -= paid;
+                residual[v] -= paid;
+            }
+        }
+
+    std::vector<std::size_t> result;
+    for (std::size_t v = 0; v < residual.size(); ++v)
+        if (!(Weight() < residual[v]))
+            result.push_back(v);
+    return result;
+}
+
 // NPC problem: Graph 3-coloring
 // Colors a 3-colorable graph with n vertices using O(sqrt(n)) colors
 // Avi Wigderson (1983)
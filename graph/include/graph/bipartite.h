@@ -1,10 +1,20 @@
 #ifndef GRAPH_BIPARTITE_H
 #define GRAPH_BIPARTITE_H
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include <structures/dynamic_matrix.h>
 #include <structures/graph.h>
 
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
 #include "max_flow_min_cut.h"
 #include "search.h"
 
@@ -115,6 +125,582 @@ std::list<std::pair<Vertex, Vertex>> maximum_bipartite_matching(
 
     return result;
 }
+
+/**
+ * Split a bipartite graph given in CSR form into its two sides by BFS 2-coloring
+ * Within each component, the first side holds the lowest-numbered vertex
+ * Throws std::domain_error if the graph is not bipartite
+ *
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+  bipartite_sides(const util::csr_graph<EdgeWeight>& input) {
+    const std::size_t UNCOLORED = -1;
+    std::vector<std::size_t> side(input.order(), UNCOLORED);
+    std::pair<std::vector<std::size_t>, std::vector<std::size_t>> result;
+    std::vector<std::size_t> queue;
+
+    for (std::size_t root = 0; root < input.order(); ++root) {
+        if (side[root] != UNCOLORED)
+            continue;
+        side[root] = 0;
+        result.first.push_back(root);
+        queue.assign(1, root);
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            std::size_t u = queue[i];
+            for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j) {
+                std::size_t v = input.targets[j];
+                if (side[v] == UNCOLORED) {
+                    side[v] = 1 - side[u];
+                    (side[v] == 0 ? result.first : result.second).push_back(v);
+                    queue.push_back(v);
+                } else if (side[v] == side[u]) {
+                    throw std::domain_error("Not a bipartite graph");
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Greedy initial matching on a bipartite graph with left vertices 0 - (offsets.size() - 2),
+ * right vertices 0 - (num_right - 1), and edges from the left stored in CSR form
+ * Any vertex left with a single unmatched neighbor is matched to it first (such a choice is
+ * always part of some maximum matching); otherwise an arbitrary edge is taken
+ *
+ * Returns the partner of each left vertex and each right vertex (the size of the opposite side
+ * if unmatched)
+ *
+ * Richard M. Karp, Michael Sipser
+ * Maximum matching in sparse random graphs
+ * (1981) doi:10.1109/SFCS.1981.21
+ * Θ(V+E)
+ */
+inline std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+  Karp_Sipser_matching(std::size_t num_right, const std::vector<std::size_t>& offsets,
+                       const std::vector<std::size_t>& targets) {
+    std::size_t num_left = offsets.size() - 1;
+    std::vector<std::size_t> match_left(num_left, num_right), match_right(num_right, num_left);
+
+    // reverse adjacency, right to left
+    std::vector<std::size_t> rev_offsets(num_right + 1, 0), rev_targets(targets.size());
+    for (std::size_t v : targets)
+        ++rev_offsets[v + 1];
+    for (std::size_t v = 0; v < num_right; ++v)
+        rev_offsets[v + 1] += rev_offsets[v];
+    std::vector<std::size_t> position(rev_offsets.begin(), rev_offsets.end() - 1);
+    for (std::size_t u = 0; u < num_left; ++u)
+        for (std::size_t j = offsets[u]; j < offsets[u + 1]; ++j)
+            rev_targets[position[targets[j]]++] = u;
+
+    // vertices are numbered 0 - (num_left - 1) on the left, then num_left onwards on the right
+    std::vector<std::size_t> degree(num_left + num_right);
+    std::vector<std::size_t> degree_one;
+    for (std::size_t u = 0; u < num_left; ++u)
+        degree[u] = offsets[u + 1] - offsets[u];
+    for (std::size_t v = 0; v < num_right; ++v)
+        degree[num_left + v] = rev_offsets[v + 1] - rev_offsets[v];
+    for (std::size_t x = 0; x < degree.size(); ++x)
+        if (degree[x] == 1)
+            degree_one.push_back(x);
+
+    auto is_matched = [&](std::size_t x) {
+        return x < num_left ? match_left[x] != num_right : match_right[x - num_left] != num_left;
+    };
+    auto match = [&](std::size_t u, std::size_t v) {
+        match_left[u] = v;
+        match_right[v] = u;
+        // the neighbors of both endpoints lose an available partner
+        for (std::size_t j = offsets[u]; j < offsets[u + 1]; ++j)
+            if (match_right[targets[j]] == num_left && --degree[num_left + targets[j]] == 1)
+                degree_one.push_back(num_left + targets[j]);
+        for (std::size_t j = rev_offsets[v]; j < rev_offsets[v + 1]; ++j)
+            if (match_left[rev_targets[j]] == num_right && --degree[rev_targets[j]] == 1)
+                degree_one.push_back(rev_targets[j]);
+    };
+
+    std::size_t next_arbitrary = 0;
+    while (true) {
+        while (!degree_one.empty()) {
+            std::size_t x = degree_one.back();
+            degree_one.pop_back();
+            if (is_matched(x) || degree[x] == 0)
+                continue;
+            if (x < num_left) {
+                for (std::size_t j = offsets[x]; j < offsets[x + 1]; ++j)
+                    if (match_right[targets[j]] == num_left) {
+                        match(x, targets[j]);
+                        break;
+                    }
+            } else {
+                std::size_t v = x - num_left;
+                for (std::size_t j = rev_offsets[v]; j < rev_offsets[v + 1]; ++j)
+                    if (match_left[rev_targets[j]] == num_right) {
+                        match(rev_targets[j], v);
+                        break;
+                    }
+            }
+        }
+
+        while (next_arbitrary < num_left &&
+               (match_left[next_arbitrary] != num_right || degree[next_arbitrary] == 0))
+            ++next_arbitrary;
+        if (next_arbitrary == num_left)
+            break;
+        for (std::size_t j = offsets[next_arbitrary]; j < offsets[next_arbitrary + 1]; ++j)
+            if (match_right[targets[j]] == num_left) {
+                match(next_arbitrary, targets[j]);
+                break;
+            }
+    }
+
+    return std::make_pair(std::move(match_left), std::move(match_right));
+}
+
+/**
+ * Maximum matching on a bipartite graph given on dense ids: left vertices are
+ * 0 - (offsets.size() - 2), right vertices are 0 - (num_right - 1), and the neighbors of left
+ * vertex u are targets[offsets[u]] ... targets[offsets[u + 1] - 1]
+ * Returns the partner of each left vertex (num_right if unmatched)
+ *
+ * Warm-started with Karp_Sipser_matching; the layering BFS of each phase runs on num_threads
+ * threads (0: all hardware threads), augmenting searches use an explicit stack
+ *
+ * John Hopcroft, Richard Karp
+ * An n^5/2 algorithm for maximum matchings in bipartite graphs
+ * (1973) doi:10.1137/0202019
+ * O(sqrt(V) E)
+ */
+inline std::vector<std::size_t> Hopcroft_Karp(std::size_t num_right,
+                                              const std::vector<std::size_t>& offsets,
+                                              const std::vector<std::size_t>& targets,
+                                              unsigned num_threads = 1) {
+    std::size_t num_left = offsets.size() - 1;
+    auto [match_left, match_right] = Karp_Sipser_matching(num_right, offsets, targets);
+
+    const std::size_t UNREACHED = -1;
+    std::vector<std::atomic<std::size_t>> dist(num_left);
+    std::vector<std::size_t> frontier, edge_pos(num_left), stack;
+    unsigned threads = util::thread_count(num_threads);
+    std::vector<std::vector<std::size_t>> next_frontiers(threads);
+
+    while (true) {
+        // BFS phase: layer the free left vertices, stop at the first layer reaching a free right
+        frontier.clear();
+        for (std::size_t u = 0; u < num_left; ++u) {
+            if (match_left[u] == num_right) {
+                dist[u].store(0, std::memory_order_relaxed);
+                frontier.push_back(u);
+            } else {
+                dist[u].store(UNREACHED, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t augment_layer = UNREACHED;
+        for (std::size_t layer = 0; !frontier.empty() && augment_layer == UNREACHED; ++layer) {
+            std::atomic<bool> found_free(false);
+            util::parallel_blocks(
+              0, frontier.size(), threads,
+              [&](unsigned id, std::size_t first, std::size_t last) {
+                  std::vector<std::size_t>& next = next_frontiers[id];
+                  for (std::size_t i = first; i < last; ++i) {
+                      std::size_t u = frontier[i];
+                      for (std::size_t j = offsets[u]; j < offsets[u + 1]; ++j) {
+                          std::size_t w = match_right[targets[j]];
+                          if (w == num_left) {
+                              found_free.store(true, std::memory_order_relaxed);
+                          } else {
+                              std::size_t expected = UNREACHED;
+                              if (dist[w].load(std::memory_order_relaxed) == UNREACHED &&
+                                  dist[w].compare_exchange_strong(expected, layer + 1,
+                                                                  std::memory_order_relaxed))
+                                  next.push_back(w);
+                          }
+                      }
+                  }
+              });
+
+            frontier.clear();
+            for (std::vector<std::size_t>& next : next_frontiers) {
+                frontier.insert(frontier.end(), next.begin(), next.end());
+                next.clear();
+            }
+            if (found_free.load())
+                augment_layer = layer;
+        }
+
+        if (augment_layer == UNREACHED)
+            break;
+
+        // DFS phase: vertex-disjoint shortest augmenting paths along the layers
+        for (std::size_t u = 0; u < num_left; ++u)
+            edge_pos[u] = offsets[u];
+        for (std::size_t root = 0; root < num_left; ++root) {
+            if (match_left[root] != num_right)
+                continue;
+
+            stack.assign(1, root);
+            while (!stack.empty()) {
+                std::size_t u = stack.back();
+                std::size_t u_dist = dist[u].load(std::memory_order_relaxed);
+                if (edge_pos[u] == offsets[u + 1]) {
+                    // dead end: never try u again this phase
+                    dist[u].store(UNREACHED, std::memory_order_relaxed);
+                    stack.pop_back();
+                    continue;
+                }
+
+                std::size_t w = match_right[targets[edge_pos[u]]];
+                if (w == num_left && u_dist == augment_layer) {
+                    for (std::size_t x : stack) {
+                        match_left[x] = targets[edge_pos[x]];
+                        match_right[targets[edge_pos[x]]] = x;
+                    }
+                    break;
+                }
+                if (w != num_left && u_dist != augment_layer &&
+                    dist[w].load(std::memory_order_relaxed) == u_dist + 1)
+                    stack.push_back(w);
+                else
+                    ++edge_pos[u];
+            }
+        }
+    }
+
+    return match_left;
+}
+
+/**
+ * Maximum bipartite matching via Hopcroft_Karp on dense ids
+ * Returns the matched pairs, each ordered (first side, second side) of the bipartition found
+ * Throws std::domain_error if the graph is not bipartite
+ *
+ * O(sqrt(V) E)
+ */
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::list<std::pair<Vertex, Vertex>> Hopcroft_Karp_matching(
+  const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& input,
+  unsigned num_threads = 1) {
+    util::csr_graph<EdgeWeight> csr = util::get_csr_rep(input);
+    std::vector<Vertex> vertices = input.vertices();
+    std::pair<std::vector<std::size_t>, std::vector<std::size_t>> side_lists =
+      bipartite_sides(csr);
+    const std::vector<std::size_t>* sides[2] = {&side_lists.first, &side_lists.second};
+    std::vector<std::size_t> local(vertices.size());
+    for (const std::vector<std::size_t>* side : sides)
+        for (std::size_t i = 0; i < side->size(); ++i)
+            local[(*side)[i]] = i;
+
+    std::vector<std::size_t> offsets(1, 0), targets;
+    targets.reserve(csr.size() / 2);
+    for (std::size_t u : *sides[0]) {
+        for (std::size_t j = csr.offsets[u]; j < csr.offsets[u + 1]; ++j)
+            targets.push_back(local[csr.targets[j]]);
+        offsets.push_back(targets.size());
+    }
+
+    std::vector<std::size_t> match =
+      Hopcroft_Karp(sides[1]->size(), offsets, targets, num_threads);
+    std::list<std::pair<Vertex, Vertex>> result;
+    for (std::size_t i = 0; i < match.size(); ++i)
+        if (match[i] != sides[1]->size())
+            result.emplace_back(vertices[(*sides[0])[i]], vertices[(*sides[1])[match[i]]]);
+
+    return result;
+}
+
+/**
+ * Minimum cost assignment on a dense cost matrix: every row is assigned a distinct column
+ * (if there are more rows than columns, every column is assigned a distinct row instead)
+ * Returns the column of each row (cost.num_cols() if the row is left unassigned)
+ *
+ * Harold W. Kuhn
+ * The Hungarian method for the assignment problem
+ * (1955) doi:10.1002/nav.3800020109
+ *
+ * James Munkres
+ * Algorithms for the assignment and transportation problems
+ * (1957) doi:10.1137/0105003
+ * Θ(n^2 m) for n = min(rows, columns), m = max(rows, columns), using dual potentials
+ */
+template<typename T> std::vector<std::size_t> Hungarian_assignment(const dynamic_matrix<T>& cost) {
+    static_assert(std::is_signed_v<T>, "Potentials require a signed cost type");
+    bool transposed = cost.num_rows() > cost.num_cols();
+    std::size_t n = transposed ? cost.num_cols() : cost.num_rows();
+    std::size_t m = transposed ? cost.num_rows() : cost.num_cols();
+    auto c = [&cost, transposed](std::size_t i, std::size_t j) -> const T& {
+        return transposed ? cost[j][i] : cost[i][j];
+    };
+
+    // 1-indexed: column 0 is a virtual column holding the row currently being inserted
+    std::vector<T> row_potential(n + 1, T()), col_potential(m + 1, T()), min_slack(m + 1);
+    std::vector<std::size_t> owner(m + 1, 0), previous(m + 1, 0);
+    std::vector<bool> visited(m + 1);
+    for (std::size_t i = 1; i <= n; ++i) {
+        owner[0] = i;
+        std::size_t current = 0;
+        std::fill(min_slack.begin(), min_slack.end(), std::numeric_limits<T>::max());
+        std::fill(visited.begin(), visited.end(), false);
+
+        // grow a shortest alternating path (Dijkstra on reduced costs) until a free column
+        do {
+            visited[current] = true;
+            std::size_t row = owner[current], next = 0;
+            T delta = std::numeric_limits<T>::max();
+            for (std::size_t j = 1; j <= m; ++j) {
+                if (visited[j])
+                    continue;
+                T slack = c(row - 1, j - 1) - row_potential[row] - col_potential[j];
+                if (slack < min_slack[j]) {
+                    min_slack[j] = slack;
+                    previous[j] = current;
+                }
+                if (min_slack[j] < delta) {
+                    delta = min_slack[j];
+                    next = j;
+                }
+            }
+            for (std::size_t j = 0; j <= m; ++j) {
+                if (visited[j]) {
+                    row_potential[owner[j]] += delta;
+                    col_potential[j] -= delta;
+                } else {
+                    min_slack[j] -= delta;
+                }
+            }
+            current = next;
+        } while (owner[current] != 0);
+
+        // flip the path
+        do {
+            std::size_t prior = previous[current];
+            owner[current] = owner[prior];
+            current = prior;
+        } while (current != 0);
+    }
+
+    std::vector<std::size_t> result(cost.num_rows(), cost.num_cols());
+    for (std::size_t j = 1; j <= m; ++j) {
+        if (owner[j] == 0)
+            continue;
+        if (transposed)
+            result[j - 1] = owner[j] - 1;
+        else
+            result[owner[j] - 1] = j - 1;
+    }
+    return result;
+}
+
+/**
+ * Minimum cost assignment on a sparse bipartite graph given on dense ids: persons are
+ * 0 - (offsets.size() - 2), objects are 0 - (num_objects - 1), and person u may take object
+ * targets[j] at cost costs[j] for offsets[u] <= j < offsets[u + 1]
+ * Every person is assigned a distinct object; returns the object of each person
+ * Throws std::domain_error if no such assignment exists
+ *
+ * Integral costs are solved exactly. Floating-point costs are solved to within
+ * (number of objects) * final_epsilon of the optimum (0: a small multiple of the largest cost)
+ *
+ * When there are more objects than persons, the surplus objects are absorbed by implicit
+ * zero-cost persons that may take any object; they bid on the cheapest objects, found in a heap
+ * of prices in O(log V) amortized per bid
+ * Bids of each round are computed on num_threads threads (0: all hardware threads) once enough
+ * persons are bidding (Jacobi auction); smaller rounds bid one at a time (Gauss-Seidel auction)
+ *
+ * Dimitri P. Bertsekas
+ * The auction algorithm: a distributed relaxation method for the assignment problem
+ * (1988) doi:10.1007/BF02186476
+ *
+ * Dimitri P. Bertsekas, David A. Castañon
+ * Parallel synchronous and asynchronous implementations of the auction algorithm
+ * (1991) doi:10.1016/0167-8191(91)90012-W
+ * O(V E log(V C)) with epsilon-scaling, C the largest absolute cost
+ */
+template<typename T>
+std::vector<std::size_t>
+  auction_assignment(std::size_t num_objects, const std::vector<std::size_t>& offsets,
+                     const std::vector<std::size_t>& targets, const std::vector<T>& costs,
+                     unsigned num_threads = 1, T final_epsilon = T()) {
+    static_assert(std::is_arithmetic_v<T>, "Costs must be numeric");
+    typedef std::conditional_t<std::is_integral_v<T>, long long, T> value_type;
+
+    std::size_t num_real = offsets.size() - 1;
+    std::vector<std::size_t> feasible = Hopcroft_Karp(num_objects, offsets, targets, num_threads);
+    if (std::count(feasible.begin(), feasible.end(), num_objects) != 0)
+        throw std::domain_error("No assignment covers every person");
+    if (num_real == 0)
+        return std::vector<std::size_t>();
+
+    // Maximize benefit = -cost. Integral benefits are scaled by (persons + 1) so that a final
+    // phase at epsilon = 1 is optimal
+    std::size_t num_persons = num_objects;
+    value_type scale = std::is_integral_v<T> ? value_type(num_persons + 1) : value_type(1);
+    std::vector<value_type> benefit(costs.size());
+    value_type largest = value_type();
+    for (std::size_t j = 0; j < costs.size(); ++j) {
+        benefit[j] = -value_type(costs[j]) * scale;
+        largest = std::max(largest, benefit[j] < 0 ? -benefit[j] : benefit[j]);
+    }
+
+    value_type epsilon_end;
+    if constexpr (std::is_integral_v<T>)
+        epsilon_end = 1;
+    else if (final_epsilon > T())
+        epsilon_end = final_epsilon;
+    else
+        epsilon_end = std::max(largest, value_type(1)) * value_type(1e-9);
+
+    const value_type SCALING_FACTOR = 5;
+    // a bid on an only option may raise the price arbitrarily, since that object belongs to
+    // this person in every assignment; keep it finite and above any competing bid
+    const value_type only_option = 2 * largest + num_persons * std::max(largest, epsilon_end);
+
+    std::vector<value_type> price(num_objects, value_type());
+    std::vector<std::size_t> owner(num_objects), assigned(num_persons);
+    std::vector<std::size_t> winner(num_objects, num_persons); // index into bids, per round
+    std::vector<std::size_t> unassigned, next_unassigned;
+    std::vector<std::pair<std::size_t, value_type>> bids(num_persons);
+
+    // the implicit persons value every object at zero, so they bid on the cheapest object at the
+    // second lowest price; prices only rise, so a min-heap of (price, object) with stale entries
+    // skipped finds both, and is rebuilt from the prices once stale entries dominate it
+    typedef std::pair<value_type, std::size_t> price_entry;
+    std::vector<price_entry> cheap(num_objects);
+    for (std::size_t object = 0; object < num_objects; ++object)
+        cheap[object] = std::make_pair(value_type(), object);
+    std::pair<std::size_t, value_type> surplus_bid;
+    auto set_price = [&](std::size_t object, value_type value) {
+        price[object] = value;
+        if (num_real == num_objects)
+            return;
+        if (cheap.size() >= 2 * num_objects) {
+            for (std::size_t k = 0; k < num_objects; ++k)
+                cheap[k] = std::make_pair(price[k], k);
+            cheap.resize(num_objects);
+            std::make_heap(cheap.begin(), cheap.end(), std::greater<price_entry>());
+        } else {
+            cheap.emplace_back(value, object);
+            std::push_heap(cheap.begin(), cheap.end(), std::greater<price_entry>());
+        }
+    };
+    auto next_cheapest = [&]() {
+        while (cheap.front().first != price[cheap.front().second]) {
+            std::pop_heap(cheap.begin(), cheap.end(), std::greater<price_entry>());
+            cheap.pop_back();
+        }
+        return cheap.front();
+    };
+    auto update_surplus_bid = [&](value_type epsilon) {
+        price_entry first = next_cheapest();
+        if (num_objects == 1) {
+            surplus_bid = std::make_pair(first.second, first.first + only_option + epsilon);
+            return;
+        }
+        std::pop_heap(cheap.begin(), cheap.end(), std::greater<price_entry>());
+        cheap.pop_back();
+        surplus_bid = std::make_pair(first.second, next_cheapest().first + epsilon);
+        cheap.push_back(first);
+        std::push_heap(cheap.begin(), cheap.end(), std::greater<price_entry>());
+    };
+
+    // best object and its bid for real person u, against the current prices
+    auto bid = [&](std::size_t u, value_type epsilon) -> std::pair<std::size_t, value_type> {
+        if (u >= num_real)
+            return surplus_bid;
+        std::size_t best = num_objects;
+        value_type best_value = value_type(), second_value = value_type();
+        bool has_second = false;
+        auto consider = [&](std::size_t object, value_type value) {
+            if (best == num_objects || value > best_value) {
+                if (best != num_objects) {
+                    second_value = best_value;
+                    has_second = true;
+                }
+                best = object;
+                best_value = value;
+            } else if (!has_second || value > second_value) {
+                second_value = value;
+                has_second = true;
+            }
+        };
+        for (std::size_t j = offsets[u]; j < offsets[u + 1]; ++j)
+            consider(targets[j], benefit[j] - price[targets[j]]);
+        value_type increment = has_second ? best_value - second_value : only_option;
+        return std::make_pair(best, price[best] + increment + epsilon);
+    };
+
+    unsigned threads = util::thread_count(num_threads);
+    const std::size_t PARALLEL_THRESHOLD = 256;
+    value_type epsilon = std::max(largest / SCALING_FACTOR, epsilon_end);
+    while (true) {
+        // each phase starts from scratch, keeping the prices of the previous phase
+        std::fill(owner.begin(), owner.end(), num_persons);
+        unassigned.resize(num_persons);
+        for (std::size_t u = 0; u < num_persons; ++u)
+            unassigned[u] = num_persons - 1 - u;
+
+        while (!unassigned.empty()) {
+            if (threads == 1 || unassigned.size() < PARALLEL_THRESHOLD) {
+                std::size_t u = unassigned.back();
+                unassigned.pop_back();
+                if (u >= num_real)
+                    update_surplus_bid(epsilon);
+                std::pair<std::size_t, value_type> b = bid(u, epsilon);
+                if (owner[b.first] != num_persons)
+                    unassigned.push_back(owner[b.first]);
+                owner[b.first] = u;
+                assigned[u] = b.first;
+                set_price(b.first, b.second);
+                continue;
+            }
+
+            // prices are fixed during a round, so all implicit persons make the same bid
+            if (num_real < num_objects)
+                update_surplus_bid(epsilon);
+            util::parallel_blocks(0, unassigned.size(), threads,
+                                  [&](unsigned, std::size_t begin, std::size_t end) {
+                                      for (std::size_t i = begin; i < end; ++i)
+                                          bids[i] = bid(unassigned[i], epsilon);
+                                  });
+
+            // the highest bid for each object wins, the previous owner is displaced
+            next_unassigned.clear();
+            for (std::size_t i = 0; i < unassigned.size(); ++i) {
+                std::size_t object = bids[i].first;
+                if (winner[object] == num_persons) {
+                    winner[object] = i;
+                } else if (bids[i].second > bids[winner[object]].second) {
+                    next_unassigned.push_back(unassigned[winner[object]]);
+                    winner[object] = i;
+                } else {
+                    next_unassigned.push_back(unassigned[i]);
+                }
+            }
+            for (std::size_t i = 0; i < unassigned.size(); ++i) {
+                std::size_t object = bids[i].first;
+                if (winner[object] != i)
+                    continue;
+                winner[object] = num_persons;
+                if (owner[object] != num_persons)
+                    next_unassigned.push_back(owner[object]);
+                owner[object] = unassigned[i];
+                assigned[unassigned[i]] = object;
+                set_price(object, bids[i].second);
+            }
+            unassigned.swap(next_unassigned);
+        }
+
+        if (!(epsilon > epsilon_end))
+            break;
+        epsilon = std::max(epsilon / SCALING_FACTOR, epsilon_end);
+    }
+
+    assigned.resize(num_real);
+    return assigned;
+}
 } // namespace graph_alg
 
 #endif // GRAPH_BIPARTITE_H
@@ -0,0 +1,265 @@
+#ifndef GRAPH_CENTRALITY_H
+#define GRAPH_CENTRALITY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+namespace graph_alg {
+/*
+ * Shortest-path centralities of a directed graph in CSR form (undirected graphs with both
+ * directions of every edge stored), from one single-source search per source
+ * Searches are breadth-first when unweighted, otherwise Dijkstra's algorithm with a binary heap on
+ * positive weights. Parallel edges make distinct paths; self-loops are never on a shortest path
+ */
+struct centrality_scores {
+    // Sum over ordered pairs (s, t) of the fraction of shortest s-t paths through each vertex
+    // other than s and t (each unordered pair counts twice on undirected graphs)
+    std::vector<double> betweenness;
+
+    // (r - 1)^2 / ((V - 1) * sum of distances to the r - 1 other vertices reachable from each;
+    // 0 if none are). Equals 1 / average distance on strongly connected graphs
+    std::vector<double> closeness;
+
+    // Sources searched, and a bound on |estimate - exact| betweenness that holds for every vertex
+    // at once with the requested probability (0 when every vertex is a source)
+    std::size_t sources = 0;
+    double error = 0;
+};
+
+/*
+ * Search state of one thread, reused from source to source: only the vertices reached by the
+ * previous source are reset
+ */
+class shortest_path_counter {
+    public:
+    explicit shortest_path_counter(std::size_t n) :
+        _distance(n, std::numeric_limits<double>::infinity()),
+        _paths(n, 0),
+        _dependency(n, 0) {}
+
+    // Distances and numbers of shortest paths from source; reached vertices in settling order
+    template<typename EdgeWeight>
+    void search(const util::csr_graph<EdgeWeight>& input, std::size_t source, bool weighted) {
+        for (std::size_t v : _order) {
+            _distance[v] = std::numeric_limits<double>::infinity();
+            _paths[v] = 0;
+            _dependency[v] = 0;
+        }
+        _order.clear();
+        _distance[source] = 0;
+        _paths[source] = 1;
+
+        if (!weighted) {
+            _order.push_back(source);
+            for (std::size_t i = 0; i < _order.size(); ++i) {
+                std::size_t v = _order[i];
+                for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                    std::size_t w = input.targets[j];
+                    if (_distance[w] == std::numeric_limits<double>::infinity()) {
+                        _distance[w] = _distance[v] + 1;
+                        _order.push_back(w);
+                    }
+                    if (_distance[w] == _distance[v] + 1)
+                        _paths[w] += _paths[v];
+                }
+            }
+            return;
+        }
+
+        // stale entries are skipped when popped; a vertex is pushed once per improvement
+        _heap.emplace(0, source);
+        while (!_heap.empty()) {
+            auto [d, v] = _heap.top();
+            _heap.pop();
+            if (d > _distance[v])
+                continue;
+            _order.push_back(v);
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                double cost = static_cast<double>(input.weights[j]);
+                if (!(cost > 0))
+                    throw std::invalid_argument("Weights must be positive");
+                std::size_t w = input.targets[j];
+                double next = _distance[v] + cost;
+                if (next < _distance[w]) {
+                    _distance[w] = next;
+                    _paths[w] = _paths[v];
+                    _heap.emplace(next, w);
+                } else if (next == _distance[w]) {
+                    _paths[w] += _paths[v];
+                }
+            }
+        }
+    }
+
+    // Dependency of the last source on every vertex, added to betweenness
+    // Successors on shortest paths are settled later, so the reverse settling order is enough;
+    // no predecessor lists are kept
+    template<typename EdgeWeight>
+    void accumulate(const util::csr_graph<EdgeWeight>& input, bool weighted,
+                    std::vector<double>& betweenness) {
+        for (std::size_t i = _order.size(); i-- > 1;) {
+            std::size_t v = _order[i];
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                std::size_t w = input.targets[j];
+                double cost = weighted ? static_cast<double>(input.weights[j]) : 1;
+                if (_distance[w] == _distance[v] + cost)
+                    _dependency[v] += _paths[v] / _paths[w] * (1 + _dependency[w]);
+            }
+            betweenness[v] += _dependency[v];
+        }
+    }
+
+    // Wasserman-Faust closeness of the last source among n vertices
+    double closeness(std::size_t n) const {
+        double sum = 0;
+        for (std::size_t v : _order)
+            sum += _distance[v];
+        double others = static_cast<double>(_order.size() - 1);
+        return sum == 0 ? 0 : others / sum * others / static_cast<double>(n - 1);
+    }
+
+    private:
+    std::vector<double> _distance, _paths, _dependency;
+    std::vector<std::size_t> _order;
+    std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>,
+                        std::greater<std::pair<double, std::size_t>>>
+      _heap;
+};
+
+// Searches from every source in the list, on num_threads threads (0: all hardware threads), each
+// accumulating betweenness into its own array; closeness is filled in for the sources only
+template<typename EdgeWeight>
+centrality_scores centrality_from_sources(const util::csr_graph<EdgeWeight>& input,
+                                          const std::vector<std::size_t>& sources, bool weighted,
+                                          unsigned num_threads) {
+    std::size_t n = input.order();
+    unsigned threads = static_cast<unsigned>(
+      std::min<std::size_t>(util::thread_count(num_threads), std::max<std::size_t>(1, n)));
+    std::vector<shortest_path_counter> counters(threads, shortest_path_counter(n));
+    std::vector<std::vector<double>> partial(threads, std::vector<double>(n, 0));
+
+    centrality_scores result;
+    result.closeness.assign(n, 0);
+    result.sources = sources.size();
+    util::parallel_for(0, sources.size(), threads, [&](unsigned id, std::size_t i) {
+        counters[id].search(input, sources[i], weighted);
+        counters[id].accumulate(input, weighted, partial[id]);
+        result.closeness[sources[i]] = counters[id].closeness(n);
+    });
+
+    result.betweenness.assign(n, 0);
+    util::parallel_blocks(0, n, threads, [&](unsigned, std::size_t first, std::size_t last) {
+        for (std::size_t v = first; v < last; ++v)
+            for (const std::vector<double>& part : partial)
+                result.betweenness[v] += part[v];
+    });
+    return result;
+}
+
+/*
+ * Exact betweenness and closeness, searching from every vertex
+ *
+ * Ulrik Brandes
+ * A faster algorithm for betweenness centrality
+ * (2001) doi:10.1080/0022250X.2001.9990249
+ * Stanley Wasserman, Katherine Faust
+ * Social network analysis: methods and applications
+ * (1994) doi:10.1017/CBO9780511815478
+ * Θ(VE) unweighted, O(VE log V) weighted; memory O(threads * V)
+ */
+template<typename EdgeWeight>
+centrality_scores shortest_path_centrality(const util::csr_graph<EdgeWeight>& input,
+                                           bool weighted = false, unsigned num_threads = 1) {
+    std::vector<std::size_t> sources(input.order());
+    std::iota(sources.begin(), sources.end(), 0);
+    return centrality_from_sources(input, sources, weighted, num_threads);
+}
+
+/*
+ * Betweenness estimated from samples sources drawn uniformly without replacement from seed, scaled
+ * by V / samples; exact once samples >= V. Closeness is computed for the sampled sources only
+ * The dependency of a source on a vertex lies in [0, V - 2], so by Hoeffding's inequality and a
+ * union bound, every estimate is within V (V - 2) sqrt(ln(2V / failure) / (2 samples)) of the
+ * exact betweenness with probability at least 1 - failure
+ *
+ * Ulrik Brandes, Christian Pich
+ * Centrality estimation in large networks
+ * (2007) doi:10.1142/S0218127407018403
+ * O(samples * E) unweighted, O(samples * E log V) weighted
+ */
+template<typename EdgeWeight>
+centrality_scores sampled_betweenness(const util::csr_graph<EdgeWeight>& input,
+                                      std::size_t samples, bool weighted = false,
+                                      unsigned num_threads = 1, std::uint64_t seed = 0,
+                                      double failure = 0.05) {
+    if (!(failure > 0 && failure < 1))
+        throw std::invalid_argument("Failure probability must lie in (0, 1)");
+    std::size_t n = input.order();
+    if (samples >= n)
+        return shortest_path_centrality(input, weighted, num_threads);
+    if (samples == 0)
+        throw std::invalid_argument("Sampling needs a source");
+
+    // partial Fisher-Yates shuffle
+    std::vector<std::size_t> sources(n);
+    std::iota(sources.begin(), sources.end(), 0);
+    std::mt19937_64 engine(seed);
+    for (std::size_t i = 0; i < samples; ++i) {
+        std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+        std::swap(sources[i], sources[pick(engine)]);
+    }
+    sources.resize(samples);
+
+    centrality_scores result = centrality_from_sources(input, sources, weighted, num_threads);
+    double scale = static_cast<double>(n) / static_cast<double>(samples);
+    for (double& value : result.betweenness)
+        value *= scale;
+    result.error = static_cast<double>(n) * static_cast<double>(n - 2) *
+                   std::sqrt(std::log(2 * static_cast<double>(n) / failure) / (2.0 * samples));
+    return result;
+}
+
+// Vertex names, numbered as in src.get_translation(); undirected graphs count every unordered
+// pair once
+template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
+std::unordered_map<Vertex, double, Args...>
+  betweenness_centrality(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& src,
+                         unsigned num_threads = 1) {
+    centrality_scores scores =
+      shortest_path_centrality(util::get_csr_rep(src), Weighted, num_threads);
+    std::vector<Vertex> vertices = src.vertices();
+    std::unordered_map<Vertex, double, Args...> result;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        result.emplace(vertices[v], Directed ? scores.betweenness[v] : scores.betweenness[v] / 2);
+    return result;
+}
+
+template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
+std::unordered_map<Vertex, double, Args...>
+  closeness_centrality(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& src,
+                       unsigned num_threads = 1) {
+    centrality_scores scores =
+      shortest_path_centrality(util::get_csr_rep(src), Weighted, num_threads);
+    std::vector<Vertex> vertices = src.vertices();
+    std::unordered_map<Vertex, double, Args...> result;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        result.emplace(vertices[v], scores.closeness[v]);
+    return result;
+}
+} // namespace graph_alg
+
+#endif // GRAPH_CENTRALITY_H
@@ -0,0 +1,254 @@
+#ifndef GRAPH_CHORDAL_H
+#define GRAPH_CHORDAL_H
+
+#include <stdexcept>
+#include <vector>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+
+#include "search.h"
+
+namespace graph_alg {
+/*
+ * Algorithms on chordal graphs: every cycle of length 4 or more has a chord
+ * Inputs are simple undirected graphs in CSR form (both directions of every edge stored); an
+ * elimination order lists the vertices first eliminated first
+ */
+
+/*
+ * Perfect elimination order of the graph if it is chordal: the reverse of a LexBFS
+ * Check with is_perfect_elimination_order
+ *
+ * Donald Rose, Robert Tarjan, George Lueker
+ * Algorithmic aspects of vertex elimination on graphs
+ * (1976) doi:10.1137/0205021
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> perfect_elimination_order(const util::csr_graph<EdgeWeight>& input) {
+    std::vector<std::size_t> order = lex_bfs(input);
+    return std::vector<std::size_t>(order.rbegin(), order.rend());
+}
+
+// For each vertex, its neighbor eliminated first after it (NONE if none), with position[v] the
+// place of v in order; higher_degree[v] counts the neighbors eliminated after v
+template<typename EdgeWeight>
+static void elimination_parents(const util::csr_graph<EdgeWeight>& input,
+                                const std::vector<std::size_t>& order,
+                                std::vector<std::size_t>& position,
+                                std::vector<std::size_t>& parent,
+                                std::vector<std::size_t>& higher_degree) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    if (order.size() != n)
+        throw std::invalid_argument("Order must hold every vertex");
+    position.assign(n, NONE);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (order[i] >= n || position[order[i]] != NONE)
+            throw std::invalid_argument("Order must be a permutation");
+        position[order[i]] = i;
+    }
+
+    parent.assign(n, NONE);
+    higher_degree.assign(n, 0);
+    for (std::size_t v = 0; v < n; ++v)
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+            std::size_t w = input.targets[j];
+            if (position[w] <= position[v])
+                continue;
+            ++higher_degree[v];
+            if (parent[v] == NONE || position[w] < position[parent[v]])
+                parent[v] = w;
+        }
+}
+
+/*
+ * Check that order is a perfect elimination order: the neighbors of each vertex eliminated after
+ * it form a clique. It suffices that they are all adjacent to the first of them (the parent)
+ *
+ * Robert Tarjan, Mihalis Yannakakis
+ * Simple linear-time algorithms to test chordality of graphs, test acyclicity of hypergraphs,
+ * and selectively reduce acyclic hypergraphs
+ * (1984) doi:10.1137/0213035
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+bool is_perfect_elimination_order(const util::csr_graph<EdgeWeight>& input,
+                                  const std::vector<std::size_t>& order) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    std::vector<std::size_t> position, parent, higher_degree;
+    elimination_parents(input, order, position, parent, higher_degree);
+
+    // children of every vertex, by counting sort
+    std::vector<std::size_t> child_offsets(n + 1, 0), children(n);
+    for (std::size_t v = 0; v < n; ++v)
+        if (parent[v] != NONE)
+            ++child_offsets[parent[v] + 1];
+    for (std::size_t v = 0; v < n; ++v)
+        child_offsets[v + 1] += child_offsets[v];
+    std::vector<std::size_t> slot(child_offsets.begin(), child_offsets.end() - 1);
+    for (std::size_t v = 0; v < n; ++v)
+        if (parent[v] != NONE)
+            children[slot[parent[v]]++] = v;
+
+    std::vector<std::size_t> mark(n, NONE);
+    for (std::size_t p = 0; p < n; ++p) {
+        for (std::size_t j = input.offsets[p]; j < input.offsets[p + 1]; ++j)
+            mark[input.targets[j]] = p;
+        for (std::size_t i = child_offsets[p]; i < child_offsets[p + 1]; ++i) {
+            std::size_t v = children[i];
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                std::size_t w = input.targets[j];
+                if (w != p && position[w] > position[v] && mark[w] != p)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Θ(V+E)
+ */
+template<typename EdgeWeight> bool is_chordal(const util::csr_graph<EdgeWeight>& input) {
+    return is_perfect_elimination_order(input, perfect_elimination_order(input));
+}
+
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+bool is_chordal(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
+    return is_chordal(util::get_csr_rep(src));
+}
+
+/*
+ * Maximal cliques of a chordal graph, joined into a clique tree: for every vertex, the cliques
+ * containing it form a subtree
+ * Clique i has tree parent parent[i] (NONE for the root of each connected component), and
+ * separator_size[i] is the size of its intersection with the parent
+ */
+struct clique_tree {
+    std::vector<std::size_t> elimination_order;
+    std::vector<std::vector<std::size_t>> cliques;
+    std::vector<std::size_t> parent;
+    std::vector<std::size_t> separator_size;
+
+    std::size_t size() const noexcept { return cliques.size(); }
+};
+
+/*
+ * Clique tree of a chordal graph; throws std::domain_error if the graph is not chordal
+ * The candidate clique of v is v with its neighbors eliminated after it; it is not maximal
+ * exactly when it is one vertex short of the candidate of a child
+ *
+ * Fanica Gavril
+ * The intersection graphs of subtrees in trees are exactly the chordal graphs
+ * (1974) doi:10.1016/0095-8956(74)90094-X
+ * Jean Blair, Barry Peyton
+ * An introduction to chordal graphs and clique trees
+ * (1993) doi:10.1007/978-1-4613-8369-7_1
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+clique_tree chordal_clique_tree(const util::csr_graph<EdgeWeight>& input) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    clique_tree result;
+    result.elimination_order = perfect_elimination_order(input);
+    if (!is_perfect_elimination_order(input, result.elimination_order))
+        throw std::domain_error("Not chordal");
+
+    std::vector<std::size_t> position, parent, higher_degree;
+    elimination_parents(input, result.elimination_order, position, parent, higher_degree);
+
+    // clique containing the candidate clique of each vertex
+    std::vector<std::size_t> clique_of(n, NONE);
+    for (std::size_t v : result.elimination_order) {
+        if (clique_of[v] == NONE) {
+            clique_of[v] = result.cliques.size();
+            std::vector<std::size_t> clique(1, v);
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                if (position[input.targets[j]] > position[v])
+                    clique.push_back(input.targets[j]);
+            result.cliques.push_back(std::move(clique));
+        }
+        std::size_t p = parent[v];
+        if (p != NONE && clique_of[p] == NONE && higher_degree[v] == higher_degree[p] + 1)
+            clique_of[p] = clique_of[v];
+    }
+
+    // the last vertex of each clique in elimination order links it to its parent clique
+    result.parent.assign(result.size(), NONE);
+    result.separator_size.assign(result.size(), 0);
+    for (std::size_t v = 0; v < n; ++v)
+        if (parent[v] != NONE && clique_of[parent[v]] != clique_of[v]) {
+            result.parent[clique_of[v]] = clique_of[parent[v]];
+            result.separator_size[clique_of[v]] = higher_degree[v];
+        }
+    return result;
+}
+
+/*
+ * Minimum coloring of a chordal graph: greedy in reverse elimination order, where the colored
+ * neighbors of every vertex form a clique
+ * Returns the color of every vertex, 0 - (ω - 1); throws std::domain_error if not chordal
+ *
+ * Fanica Gavril
+ * Algorithms for minimum coloring, maximum clique, minimum covering by cliques, and maximum
+ * independent set of a chordal graph
+ * (1972) doi:10.1137/0201013
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> chordal_coloring(const util::csr_graph<EdgeWeight>& input) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    std::vector<std::size_t> order = perfect_elimination_order(input);
+    if (!is_perfect_elimination_order(input, order))
+        throw std::domain_error("Not chordal");
+
+    std::vector<std::size_t> color(n, NONE), used(n + 1, NONE);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        std::size_t v = *it;
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            if (color[input.targets[j]] != NONE)
+                used[color[input.targets[j]]] = v;
+        std::size_t c = 0;
+        while (used[c] == v)
+            ++c;
+        color[v] = c;
+    }
+    return color;
+}
+
+/*
+ * Maximum independent set of a chordal graph: greedy in elimination order
+ * Throws std::domain_error if not chordal
+ *
+ * Fanica Gavril
+ * Algorithms for minimum coloring, maximum clique, minimum covering by cliques, and maximum
+ * independent set of a chordal graph
+ * (1972) doi:10.1137/0201013
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> chordal_independent_set(const util::csr_graph<EdgeWeight>& input) {
+    std::vector<std::size_t> order = perfect_elimination_order(input);
+    if (!is_perfect_elimination_order(input, order))
+        throw std::domain_error("Not chordal");
+
+    std::vector<bool> blocked(input.order(), false);
+    std::vector<std::size_t> result;
+    for (std::size_t v : order) {
+        if (blocked[v])
+            continue;
+        result.push_back(v);
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            blocked[input.targets[j]] = true;
+    }
+    return result;
+}
+} // namespace graph_alg
+
+#endif // GRAPH_CHORDAL_H
@@ -3,12 +3,17 @@
 #ifndef GRAPH_CLOSURE_H
 #define GRAPH_CLOSURE_H
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <functional>
 
 #include <graph/components.h>
 #include <structures/dynamic_matrix.h>
 #include <structures/graph.h>
 #include <unordered_set>
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
 
 #include "search.h"
 
@@ -17,38 +22,160 @@ namespace graph_alg {
  * An assortment of closure algorithms on graphs
  */
 
+// Bucket-based peeling: order receives the vertices in the order they are removed, smallest
+// current degree first, and core the core number of every vertex
+template<typename EdgeWeight>
+static void degeneracy_peeling(const util::csr_graph<EdgeWeight>& input,
+                               std::vector<std::size_t>& core, std::vector<std::size_t>& order) {
+    std::size_t n = input.order();
+    core.resize(n);
+    order.resize(n);
+    // vertices sorted by current degree; bin[d] is where degree d starts
+    std::size_t max_degree = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+        core[v] = input.degree(v);
+        max_degree = std::max(max_degree, core[v]);
+    }
+    std::vector<std::size_t> bin(max_degree + 2, 0), position(n);
+    for (std::size_t v = 0; v < n; ++v)
+        ++bin[core[v] + 1];
+    for (std::size_t d = 0; d <= max_degree; ++d)
+        bin[d + 1] += bin[d];
+    for (std::size_t v = 0; v < n; ++v) {
+        position[v] = bin[core[v]]++;
+        order[position[v]] = v;
+    }
+    for (std::size_t d = max_degree; d > 0; --d)
+        bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t v = order[i];
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+            std::size_t w = input.targets[j];
+            if (core[w] <= core[v])
+                continue;
+            // move w to the front of its bin, then shrink the bin past it
+            std::size_t first = order[bin[core[w]]];
+            if (first != w) {
+                std::swap(order[position[w]], order[bin[core[w]]]);
+                std::swap(position[w], position[first]);
+            }
+            ++bin[core[w]];
+            --core[w];
+        }
+    }
+}
+
+/**
+ * Core number of every vertex of an undirected graph in CSR form (both directions of every edge
+ * stored): the largest k such that the vertex is in the k-core
+ *
+ * num_threads = 1: bucket-based peeling in order of current degree
+ * Vladimir Batagelj, Matjaž Zaveršnik
+ * An O(m) algorithm for cores decomposition of networks
+ * (2003) arXiv:cs/0310049
+ * Θ(V+E)
+ *
+ * Otherwise: level-synchronous peeling, where every vertex of degree at most k is removed at once
+ * and neighbor degrees drop atomically, on num_threads threads (0: all hardware threads)
+ * Naga Shailaja Dasari, Ranjan Desh, Mohammad Zubair
+ * ParK: an efficient algorithm for k-core decomposition on multicore processors
+ * (2014) doi:10.1109/BigData.2014.7004366
+ * O(V+E) work per peeling round, plus a scan of the remaining vertices per level
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> core_numbers(const util::csr_graph<EdgeWeight>& input,
+                                      unsigned num_threads = 1) {
+    std::size_t n = input.order();
+    std::vector<std::size_t> core(n);
+    if (n == 0)
+        return core;
+
+    if (util::thread_count(num_threads) == 1) {
+        std::vector<std::size_t> order;
+        degeneracy_peeling(input, core, order);
+        return core;
+    }
+
+    std::vector<std::atomic<std::size_t>> degree(n);
+    std::vector<std::atomic<bool>> removed(n);
+    std::vector<std::size_t> remaining(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        degree[v].store(input.degree(v), std::memory_order_relaxed);
+        removed[v].store(false, std::memory_order_relaxed);
+        remaining[v] = v;
+    }
+
+    unsigned threads = util::thread_count(num_threads);
+    std::vector<std::vector<std::size_t>> next_frontier(threads);
+    std::vector<std::size_t> frontier;
+    for (std::size_t k = 0; !remaining.empty(); ++k) {
+        // skip empty levels, then start from every remaining vertex of degree at most k
+        std::size_t min_degree = degree[remaining.front()].load(std::memory_order_relaxed);
+        for (std::size_t v : remaining)
+            min_degree = std::min(min_degree, degree[v].load(std::memory_order_relaxed));
+        k = std::max(k, min_degree);
+        frontier.clear();
+        for (std::size_t v : remaining)
+            if (degree[v].load(std::memory_order_relaxed) <= k) {
+                removed[v].store(true, std::memory_order_relaxed);
+                frontier.push_back(v);
+            }
+
+        while (!frontier.empty()) {
+            util::parallel_for(
+              0, frontier.size(), threads,
+              [&](unsigned id, std::size_t i) {
+                  std::size_t v = frontier[i];
+                  core[v] = k;
+                  for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                      std::size_t w = input.targets[j];
+                      if (removed[w].load(std::memory_order_relaxed))
+                          continue;
+                      // only the decrement that brings w down to k queues it
+                      if (degree[w].fetch_sub(1, std::memory_order_relaxed) == k + 1) {
+                          removed[w].store(true, std::memory_order_relaxed);
+                          next_frontier[id].push_back(w);
+                      }
+                  }
+              },
+              256);
+            frontier.clear();
+            for (std::vector<std::size_t>& local : next_frontier) {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+                local.clear();
+            }
+        }
+
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&removed](std::size_t v) {
+                                           return removed[v].load(std::memory_order_relaxed);
+                                       }),
+                        remaining.end());
+    }
+    return core;
+}
+
 /**
  * find k-core: maximum induced subgraph with all degrees >= k
+ * Read off the core numbers, without peeling a copy of the graph
  * David W. Matula and Leland D. Beck:
  * Smallest-Last Ordering and Clustering and Graph Coloring Algorithms
  * (1983) doi:10.1145/2402.322385
- * Θ(V)
+ * Θ(V+E) for the core numbers
  */
 template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
 graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>
-  k_core(graph::graph<Vertex, false, Weighted, EdgeWeight, Args...> src, uint32_t k) {
-    // Since we are strictly removing edges, if a vertex falls below
-    // threshold, we know it has to go
-    std::unordered_map<Vertex, uint32_t, Args...> degree;
-    std::list<Vertex> to_remove;
-    for (const Vertex& vertex : src.vertices()) {
-        degree[vertex] = src.degree(vertex);
-        if (degree[vertex] < k)
-            to_remove.push_back(vertex);
-    }
-
-    while (!to_remove.empty()) {
-        Vertex target = to_remove.back();
-        to_remove.pop_front();
-        for (const Vertex& neighbor : src.neighbors(target)) {
-            --degree[neighbor];
-            if (degree[neighbor] < k)
-                to_remove.push_back(neighbor);
-        }
-        src.remove(target);
-    }
+  k_core(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src, uint32_t k) {
+    std::vector<Vertex> vertices = src.vertices();
+    std::vector<std::size_t> core = core_numbers(util::get_csr_rep(src));
 
-    return src;
+    std::vector<Vertex> members;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        if (core[v] >= k)
+            members.push_back(vertices[v]);
+    return src.generate_induced_subgraph(members.begin(), members.end());
 }
 
 /**
@@ -210,6 +337,114 @@ graph::unweighted_graph<Vertex, true, Args...>
     return result;
 }
 
+/**
+ * Transitive closure of a directed graph on dense ids, stored as one bit row per strongly
+ * connected component
+ * Bit d of row c is set if component d is reachable from component c (including c itself);
+ * since components are numbered in reverse topological order, row c only holds bits 0 - c
+ */
+struct reachability_closure {
+    condensation scc;
+    std::vector<std::size_t> row_offsets; // row c is words [row_offsets[c], row_offsets[c + 1])
+    std::vector<std::uint64_t> rows;
+
+    // Whether vertex v can be reached from vertex u
+    bool reaches(std::size_t u, std::size_t v) const noexcept {
+        std::size_t c = scc.component[u], d = scc.component[v];
+        return d <= c && (rows[row_offsets[c] + d / 64] >> (d % 64) & 1) != 0;
+    }
+};
+
+/**
+ * Transitive closure of a directed graph in CSR form
+ * Strongly connected components are condensed first; the rows of the condensation are then
+ * filled in reverse topological order by OR-ing the rows of successors, 64 bits per word.
+ * Successors are taken from the highest id down, skipping any already reached through another
+ * Components of equal depth in the condensation are independent, and are filled concurrently on
+ * num_threads threads (0: all hardware threads)
+ *
+ * Esko Nuutila
+ * An efficient transitive closure algorithm for cyclic digraphs
+ * (1994) doi:10.1016/0020-0190(94)00115-8
+ * O(V+E) condensation, then O(kE/64) words for k components
+ */
+template<typename EdgeWeight>
+reachability_closure bit_transitive_closure(const util::csr_graph<EdgeWeight>& input,
+                                            unsigned num_threads = 1) {
+    reachability_closure result;
+    result.scc = strongly_connected_condensation(input, num_threads);
+    const util::csr_graph<std::size_t>& dag = result.scc.dag;
+    std::size_t k = dag.order();
+
+    result.row_offsets.resize(k + 1);
+    result.row_offsets[0] = 0;
+    for (std::size_t c = 0; c < k; ++c)
+        result.row_offsets[c + 1] = result.row_offsets[c] + c / 64 + 1;
+    result.rows.assign(result.row_offsets[k], 0);
+
+    // group components by depth: longest path to a sink
+    std::vector<std::size_t> depth(k, 0);
+    std::size_t max_depth = 0;
+    for (std::size_t c = 0; c < k; ++c) {
+        for (std::size_t j = dag.offsets[c]; j < dag.offsets[c + 1]; ++j)
+            depth[c] = std::max(depth[c], depth[dag.targets[j]] + 1);
+        max_depth = std::max(max_depth, depth[c]);
+    }
+    std::vector<std::size_t> level_offsets(max_depth + 2, 0), by_level(k);
+    for (std::size_t c = 0; c < k; ++c)
+        ++level_offsets[depth[c] + 1];
+    for (std::size_t l = 0; l <= max_depth; ++l)
+        level_offsets[l + 1] += level_offsets[l];
+    std::vector<std::size_t> position(level_offsets.begin(), level_offsets.end() - 1);
+    for (std::size_t c = 0; c < k; ++c)
+        by_level[position[depth[c]]++] = c;
+
+    std::vector<std::vector<std::size_t>> successors(util::thread_count(num_threads));
+    for (std::size_t l = 0; l <= max_depth; ++l)
+        util::parallel_for(
+          level_offsets[l], level_offsets[l + 1], num_threads,
+          [&](unsigned id, std::size_t i) {
+              std::size_t c = by_level[i];
+              std::uint64_t* row = result.rows.data() + result.row_offsets[c];
+              row[c / 64] |= std::uint64_t(1) << (c % 64);
+
+              std::vector<std::size_t>& next = successors[id];
+              next.assign(dag.targets.begin() + dag.offsets[c],
+                          dag.targets.begin() + dag.offsets[c + 1]);
+              std::sort(next.begin(), next.end(), std::greater<std::size_t>());
+              for (std::size_t d : next) {
+                  if ((row[d / 64] >> (d % 64) & 1) != 0)
+                      continue;
+                  const std::uint64_t* other = result.rows.data() + result.row_offsets[d];
+                  for (std::size_t w = 0; w <= d / 64; ++w)
+                      row[w] |= other[w];
+              }
+          },
+          16);
+
+    return result;
+}
+
+/**
+ * Find the transitive closure of a graph by bit-parallel reachability (self-loops omitted)
+ */
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+graph::unweighted_graph<Vertex, true, Args...>
+  transitive_closure(const graph::graph<Vertex, true, Weighted, EdgeWeight, Args...>& src,
+                     unsigned num_threads) {
+    std::vector<Vertex> vertices = src.vertices();
+    reachability_closure closure = bit_transitive_closure(util::get_csr_rep(src), num_threads);
+
+    graph::unweighted_graph<Vertex, true, Args...> result;
+    for (const Vertex& v : vertices)
+        result.add_vertex(v);
+    for (std::size_t u = 0; u < vertices.size(); ++u)
+        for (std::size_t v = 0; v < vertices.size(); ++v)
+            if (u != v && closure.reaches(u, v))
+                result.force_add(vertices[u], vertices[v]);
+    return result;
+}
+
 /**
  * Chvatal-Bondy closure
  * If the sum of the degrees of two vertices exceed k, there should be an edge between them.
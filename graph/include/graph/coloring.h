@@ -0,0 +1,260 @@
+#ifndef GRAPH_COLORING_H
+#define GRAPH_COLORING_H
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+#include "closure.h"
+
+namespace graph_alg {
+/*
+ * Vertex coloring heuristics: adjacent vertices get different colors 0 - (k - 1)
+ * Inputs are undirected graphs in CSR form (both directions of every edge stored); self-loops are
+ * ignored
+ * The colors around a vertex are collected in a bitset of one bit per color, and the first free
+ * color is found a word at a time
+ */
+
+// Lowest color whose bit is clear; forbidden has a clear bit in range
+static std::size_t first_free_color(const std::vector<std::uint64_t>& forbidden,
+                                    std::size_t first_word = 0) {
+    std::size_t i = first_word;
+    while (~forbidden[i] == 0)
+        ++i;
+    return (i - first_word) * 64 + std::countr_zero(~forbidden[i]);
+}
+
+template<typename EdgeWeight>
+static std::size_t max_degree(const util::csr_graph<EdgeWeight>& input) {
+    std::size_t result = 0;
+    for (std::size_t v = 0; v < input.order(); ++v)
+        result = std::max(result, input.degree(v));
+    return result;
+}
+
+/*
+ * Greedy (first-fit) coloring in the given order: every vertex takes the lowest color not used
+ * by its neighbors colored before it
+ * Uses at most Δ + 1 colors, and at most d + 1 when every vertex has at most d neighbors before it
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> greedy_coloring(const util::csr_graph<EdgeWeight>& input,
+                                         const std::vector<std::size_t>& order) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    if (order.size() != n)
+        throw std::invalid_argument("Order must hold every vertex");
+
+    std::vector<std::size_t> color(n, NONE);
+    std::vector<std::uint64_t> forbidden(max_degree(input) / 64 + 1, 0);
+    for (std::size_t v : order) {
+        if (v >= n || color[v] != NONE)
+            throw std::invalid_argument("Order must be a permutation");
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+            std::size_t c = color[input.targets[j]];
+            if (c != NONE)
+                forbidden[c / 64] |= std::uint64_t(1) << (c % 64);
+        }
+        color[v] = first_free_color(forbidden);
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            if (color[input.targets[j]] != NONE)
+                forbidden[color[input.targets[j]] / 64] = 0;
+    }
+    return color;
+}
+
+/*
+ * Smallest-last order: the reverse of repeatedly removing a vertex of least remaining degree, so
+ * that every vertex has at most degeneracy neighbors before it
+ *
+ * David Matula, Leland Beck
+ * Smallest-last ordering and clustering and graph coloring algorithms
+ * (1983) doi:10.1145/2402.322385
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> smallest_last_order(const util::csr_graph<EdgeWeight>& input) {
+    std::vector<std::size_t> core, order;
+    degeneracy_peeling(input, core, order);
+    return std::vector<std::size_t>(order.rbegin(), order.rend());
+}
+
+/*
+ * Greedy coloring in smallest-last order: at most degeneracy + 1 colors
+ * Θ(V+E)
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> smallest_last_coloring(const util::csr_graph<EdgeWeight>& input) {
+    return greedy_coloring(input, smallest_last_order(input));
+}
+
+// Vertex names, numbered as in src.get_translation()
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::unordered_map<Vertex, std::size_t, Args...>
+  smallest_last_coloring(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
+    std::vector<std::size_t> color = smallest_last_coloring(util::get_csr_rep(src));
+    std::vector<Vertex> vertices = src.vertices();
+    std::unordered_map<Vertex, std::size_t, Args...> result;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        result.emplace(vertices[v], color[v]);
+    return result;
+}
+
+/*
+ * DSATUR: always color next the vertex seeing the most distinct colors (its saturation), ties
+ * going to the highest degree, then the lowest id. Exact on bipartite graphs
+ * Every vertex keeps a bitset of the colors 0 - degree around it, which holds its first free
+ * color; the rare higher colors only count towards saturation, through a shared hash set
+ *
+ * Daniel Brélaz
+ * New methods to color the vertices of a graph
+ * (1979) doi:10.1145/359094.359101
+ * O((V+E) log V)
+ * Memory: O(V + E/64) words
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> saturation_coloring(const util::csr_graph<EdgeWeight>& input) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order(), span = max_degree(input) + 1;
+    std::vector<std::size_t> color(n, NONE), saturation(n, 0), word_offsets(n + 1, 0);
+    for (std::size_t v = 0; v < n; ++v)
+        word_offsets[v + 1] = word_offsets[v] + input.degree(v) / 64 + 1;
+    std::vector<std::uint64_t> seen(word_offsets[n], 0);
+    std::unordered_set<std::uint64_t> seen_above;
+
+    // stale entries are skipped when popped
+    typedef std::tuple<std::size_t, std::size_t, std::size_t> entry; // saturation, degree, ~id
+    std::priority_queue<entry> next;
+    for (std::size_t v = 0; v < n; ++v)
+        next.emplace(0, input.degree(v), ~v);
+    while (!next.empty()) {
+        std::size_t v = ~std::get<2>(next.top());
+        bool stale = color[v] != NONE || std::get<0>(next.top()) != saturation[v];
+        next.pop();
+        if (stale)
+            continue;
+
+        std::size_t c = first_free_color(seen, word_offsets[v]);
+        color[v] = c;
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+            std::size_t w = input.targets[j];
+            if (color[w] != NONE)
+                continue;
+            bool added;
+            if (c <= input.degree(w)) {
+                std::uint64_t& word = seen[word_offsets[w] + c / 64];
+                std::uint64_t bit = std::uint64_t(1) << (c % 64);
+                added = (word & bit) == 0;
+                word |= bit;
+            } else {
+                added = seen_above.insert(std::uint64_t(w) * span + c).second;
+            }
+            if (added)
+                next.emplace(++saturation[w], input.degree(w), ~w);
+        }
+    }
+    return color;
+}
+
+/*
+ * Jones-Plassmann parallel greedy coloring: every vertex gets a pseudo-random priority from seed,
+ * and is colored first-fit once all of its neighbors of higher priority are. The vertices ready in
+ * a round are independent, and are colored concurrently on num_threads threads (0: all hardware
+ * threads); the coloring depends on seed only, not on the number of threads
+ *
+ * Mark Jones, Paul Plassmann
+ * A parallel graph coloring heuristic
+ * (1993) doi:10.1137/0914041
+ * O(V+E) work, in as many rounds as the longest path of decreasing priority
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> Jones_Plassmann_coloring(const util::csr_graph<EdgeWeight>& input,
+                                                  unsigned num_threads = 1,
+                                                  std::uint64_t seed = 0) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    unsigned threads = util::thread_count(num_threads);
+
+    // splitmix64 of the id, ties broken by id
+    std::vector<std::uint64_t> priority(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        std::uint64_t z = seed + (v + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        priority[v] = z ^ (z >> 31);
+    }
+    auto before = [&priority](std::size_t u, std::size_t v) {
+        return priority[u] > priority[v] || (priority[u] == priority[v] && u > v);
+    };
+
+    std::vector<std::atomic<std::size_t>> waiting(n);
+    std::vector<std::size_t> frontier;
+    for (std::size_t v = 0; v < n; ++v) {
+        std::size_t count = 0;
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            count += before(input.targets[j], v);
+        waiting[v].store(count, std::memory_order_relaxed);
+        if (count == 0)
+            frontier.push_back(v);
+    }
+
+    std::vector<std::size_t> color(n, NONE);
+    std::vector<std::vector<std::uint64_t>> forbidden(
+      threads, std::vector<std::uint64_t>(max_degree(input) / 64 + 1, 0));
+    std::vector<std::vector<std::size_t>> next_frontier(threads);
+    while (!frontier.empty()) {
+        // only neighbors of higher priority are colored, all in earlier rounds
+        util::parallel_for(
+          0, frontier.size(), threads,
+          [&](unsigned id, std::size_t i) {
+              std::size_t v = frontier[i];
+              std::vector<std::uint64_t>& bits = forbidden[id];
+              for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                  std::size_t c = color[input.targets[j]];
+                  if (c != NONE)
+                      bits[c / 64] |= std::uint64_t(1) << (c % 64);
+              }
+              std::size_t c = first_free_color(bits);
+              for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                  if (color[input.targets[j]] != NONE)
+                      bits[color[input.targets[j]] / 64] = 0;
+              color[v] = c;
+          },
+          256);
+
+        util::parallel_for(
+          0, frontier.size(), threads,
+          [&](unsigned id, std::size_t i) {
+              std::size_t v = frontier[i];
+              for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                  std::size_t w = input.targets[j];
+                  if (before(v, w) && waiting[w].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                      next_frontier[id].push_back(w);
+              }
+          },
+          256);
+
+        frontier.clear();
+        for (std::vector<std::size_t>& part : next_frontier) {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+            part.clear();
+        }
+    }
+    return color;
+}
+} // namespace graph_alg
+
+#endif // GRAPH_COLORING_H
@@ -1,13 +1,26 @@
 #ifndef GRAPH_COMPONENTS_H
 #define GRAPH_COMPONENTS_H
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <iterator>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include <structures/disjoint_set.h>
 #include <structures/graph.h>
 
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
 #include "search.h"
 
 namespace graph_alg {
@@ -33,6 +46,276 @@ std::list<std::unordered_set<Vertex, Args...>>
     return result;
 }
 
+/*
+Connected components of an undirected graph in CSR form (both directions of every edge stored)
+Returns the component of each vertex, numbered 0 - (k - 1) in order of their smallest vertex
+
+The first two neighbors of every vertex are joined first; the largest component is then
+estimated from a sample, and its members skip their remaining edges, which mostly lie inside it
+Joins go through a concurrent_disjoint_set on num_threads threads (0: all hardware threads)
+
+Michael Sutton, Tal Ben-Nun, Amnon Barak
+Optimizing parallel graph connectivity computation via subgraph sampling
+(2018) doi:10.1109/IPDPS.2018.00118
+O(E α(V)) work
+*/
+template<typename EdgeWeight>
+std::vector<std::size_t> Afforest_components(const util::csr_graph<EdgeWeight>& input,
+                                             unsigned num_threads = 1) {
+    const std::size_t NEIGHBOR_ROUNDS = 2, SAMPLE_SIZE = 1024, GRAIN = 1024;
+    std::size_t n = input.order();
+    concurrent_disjoint_set<> components(n);
+
+    for (std::size_t round = 0; round < NEIGHBOR_ROUNDS; ++round)
+        util::parallel_blocks(0, n, num_threads, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v)
+                if (round < input.degree(v))
+                    components.union_sets(v, input.targets[input.offsets[v] + round]);
+        });
+
+    // most frequent root among a sample approximates the largest component
+    std::size_t largest = n;
+    if (n != 0) {
+        std::minstd_rand engine(n);
+        std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+        std::unordered_map<std::size_t, std::size_t> frequency;
+        std::size_t best_count = 0;
+        for (std::size_t i = 0; i < SAMPLE_SIZE; ++i) {
+            std::size_t root = components.find(vertex_dist(engine));
+            if (++frequency[root] > best_count) {
+                best_count = frequency[root];
+                largest = root;
+            }
+        }
+    }
+
+    util::parallel_for(
+      0, n, num_threads,
+      [&](unsigned, std::size_t v) {
+          if (components.same_set(v, largest))
+              return;
+          for (std::size_t j = input.offsets[v] + NEIGHBOR_ROUNDS; j < input.offsets[v + 1]; ++j)
+              components.union_sets(v, input.targets[j]);
+      },
+      GRAIN);
+
+    std::vector<std::size_t> result(n);
+    util::parallel_blocks(0, n, num_threads, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t v = begin; v < end; ++v)
+            result[v] = components.find(v);
+    });
+
+    // compact the roots into 0 - (k - 1)
+    std::vector<std::size_t> id(n, n);
+    std::size_t num_components = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+        if (id[result[v]] == n)
+            id[result[v]] = num_components++;
+        result[v] = id[result[v]];
+    }
+    return result;
+}
+
+/*
+Connected components using Afforest_components on num_threads threads (0: all hardware threads)
+Components are listed in order of their first vertex in src.vertices()
+*/
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::list<std::unordered_set<Vertex, Args...>>
+  connected_components(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src,
+                       unsigned num_threads) {
+    std::vector<Vertex> vertices = src.vertices();
+    std::vector<std::size_t> labels = Afforest_components(util::get_csr_rep(src), num_threads);
+
+    std::vector<std::unordered_set<Vertex, Args...>> components;
+    for (std::size_t v = 0; v < vertices.size(); ++v) {
+        if (labels[v] == components.size())
+            components.emplace_back();
+        components[labels[v]].insert(vertices[v]);
+    }
+    return std::list<std::unordered_set<Vertex, Args...>>(
+      std::make_move_iterator(components.begin()), std::make_move_iterator(components.end()));
+}
+
+/*
+Biconnected components (blocks) of an undirected graph on dense ids
+Every edge belongs to exactly one block; isolated vertices belong to none
+block_cut_tree has a node for each block (0 - (k - 1)) and for each cut vertex (k + i for
+cut_vertices[i]), with an edge in both directions wherever a block contains a cut vertex, weighted
+by the number of block edges incident to it
+*/
+struct block_decomposition {
+    std::vector<std::size_t> edge_block;                      // per CSR edge, NONE for self-loops
+    std::vector<std::pair<std::size_t, std::size_t>> bridges; // (parent, child) in the DFS forest
+    std::vector<std::size_t> cut_vertices;                    // ascending
+    util::csr_graph<std::size_t> block_cut_tree;
+    std::size_t num_blocks = 0;
+
+    std::size_t size() const noexcept { return num_blocks; }
+};
+
+/*
+Blocks, bridges and cut vertices of an undirected graph in CSR form (both directions of every
+edge stored), in one pass of depth_first_visit
+Each vertex is labeled with the block of the tree edge to its parent; any other edge belongs to
+the block of its deeper endpoint. Parallel edges are allowed
+
+John Hopcroft, Robert Tarjan
+Algorithm 447: efficient algorithms for graph manipulation
+(1973) doi:10.1145/362248.362272
+Θ(V+E)
+*/
+template<typename EdgeWeight>
+block_decomposition biconnected_blocks(const util::csr_graph<EdgeWeight>& input) {
+    const std::size_t NONE = depth_first_state::NONE;
+    std::size_t n = input.order();
+    block_decomposition result;
+
+    depth_first_state state(n);
+    std::vector<std::size_t> low(n), parent(n, NONE), block(n, NONE), vertex_stack;
+    std::vector<char> parent_edge_seen(n, false), is_cut(n, false);
+    for (std::size_t root = 0; root < n; ++root) {
+        if (state.visited(root))
+            continue;
+        std::size_t num_children_of_root = 0;
+
+        depth_first_visit(
+          input, root, state,
+          [&](std::size_t v) {
+              low[v] = state.discovered[v];
+              vertex_stack.push_back(v);
+          },
+          [&](std::size_t u, std::size_t w, dfs_edge kind) {
+              if (kind == dfs_edge::tree) {
+                  parent[w] = u;
+              } else if (w == parent[u] && !parent_edge_seen[u]) {
+                  // the tree edge seen from below; any parallel copy is a back edge
+                  parent_edge_seen[u] = true;
+              } else if (kind == dfs_edge::back) {
+                  low[u] = std::min(low[u], state.discovered[w]);
+              }
+          },
+          [&](std::size_t p, std::size_t v) {
+              if (p == NONE)
+                  return;
+              low[p] = std::min(low[p], low[v]);
+              if (low[v] < state.discovered[p])
+                  return;
+
+              // nothing below v reaches above p: the tree edge p-v closes a block
+              if (low[v] > state.discovered[p])
+                  result.bridges.emplace_back(p, v);
+              if (p == root)
+                  ++num_children_of_root;
+              else
+                  is_cut[p] = true;
+              std::size_t x;
+              do {
+                  x = vertex_stack.back();
+                  vertex_stack.pop_back();
+                  block[x] = result.num_blocks;
+              } while (x != v);
+              ++result.num_blocks;
+          });
+
+        vertex_stack.clear();
+        if (num_children_of_root > 1)
+            is_cut[root] = true;
+    }
+
+    result.edge_block.resize(input.size());
+    for (std::size_t u = 0; u < n; ++u)
+        for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j) {
+            std::size_t w = input.targets[j];
+            if (u == w)
+                result.edge_block[j] = NONE;
+            else
+                result.edge_block[j] = block[state.discovered[u] > state.discovered[w] ? u : w];
+        }
+
+    // block-cut tree: link each cut vertex to every block among its edges
+    std::size_t k = result.num_blocks;
+    std::vector<std::size_t> last_cut(k, NONE), slot(k);
+    std::vector<std::pair<std::size_t, std::size_t>> links; // (block, cut vertex index)
+    std::vector<std::size_t> link_weight;
+    for (std::size_t v = 0; v < n; ++v) {
+        if (!is_cut[v])
+            continue;
+        std::size_t i = result.cut_vertices.size();
+        result.cut_vertices.push_back(v);
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+            std::size_t b = result.edge_block[j];
+            if (b == NONE)
+                continue;
+            if (last_cut[b] != i) {
+                last_cut[b] = i;
+                slot[b] = links.size();
+                links.emplace_back(b, i);
+                link_weight.push_back(0);
+            }
+            ++link_weight[slot[b]];
+        }
+    }
+
+    util::csr_graph<std::size_t>& tree = result.block_cut_tree;
+    tree.offsets.assign(k + result.cut_vertices.size() + 1, 0);
+    tree.targets.resize(2 * links.size());
+    tree.weights.resize(2 * links.size());
+    for (const std::pair<std::size_t, std::size_t>& link : links) {
+        ++tree.offsets[link.first + 1];
+        ++tree.offsets[k + link.second + 1];
+    }
+    for (std::size_t i = 1; i < tree.offsets.size(); ++i)
+        tree.offsets[i] += tree.offsets[i - 1];
+    std::vector<std::size_t> position(tree.offsets.begin(), tree.offsets.end() - 1);
+    for (std::size_t i = 0; i < links.size(); ++i) {
+        std::size_t b = links[i].first, c = k + links[i].second;
+        tree.targets[position[b]] = c;
+        tree.weights[position[b]++] = link_weight[i];
+        tree.targets[position[c]] = b;
+        tree.weights[position[c]++] = link_weight[i];
+    }
+
+    return result;
+}
+
+/*
+Vertex sets of the biconnected components of a graph
+A vertex is in several components exactly when it is an articulation point
+Θ(V+E)
+*/
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::list<std::unordered_set<Vertex, Args...>>
+  biconnected_components(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
+    std::vector<Vertex> vertices = src.vertices();
+    util::csr_graph<EdgeWeight> input = util::get_csr_rep(src);
+    block_decomposition blocks = biconnected_blocks(input);
+
+    std::vector<std::unordered_set<Vertex, Args...>> members(blocks.size());
+    for (std::size_t u = 0; u < vertices.size(); ++u)
+        for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j)
+            if (blocks.edge_block[j] != depth_first_state::NONE)
+                members[blocks.edge_block[j]].insert(vertices[u]);
+    return std::list<std::unordered_set<Vertex, Args...>>(
+      std::make_move_iterator(members.begin()), std::make_move_iterator(members.end()));
+}
+
+/*
+Edges whose removal disconnects their endpoints
+Θ(V+E)
+*/
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::list<std::pair<Vertex, Vertex>>
+  bridges(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
+    std::vector<Vertex> vertices = src.vertices();
+    block_decomposition blocks = biconnected_blocks(util::get_csr_rep(src));
+
+    std::list<std::pair<Vertex, Vertex>> result;
+    for (const std::pair<std::size_t, std::size_t>& e : blocks.bridges)
+        result.emplace_back(vertices[e.first], vertices[e.second]);
+    return result;
+}
+
 /*
 Find all articulation points of a graph
 John Hopcroft, Robert Tarjan
@@ -43,133 +326,341 @@ Algorithm 447: efficient algorithms for graph manipulation
 template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
 std::unordered_set<Vertex, Args...>
   articulation_points(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
-    std::unordered_map<Vertex, bool, Args...> visited;
-    std::unordered_map<Vertex, uint32_t, Args...> search_number, low;
-    uint32_t current_dfs_num = 0;
+    std::vector<Vertex> vertices = src.vertices();
+    block_decomposition blocks = biconnected_blocks(util::get_csr_rep(src));
+
     std::unordered_set<Vertex, Args...> result;
+    for (std::size_t v : blocks.cut_vertices)
+        result.insert(vertices[v]);
+    return result;
+}
 
-    if (src.order() == 0)
-        return result;
+/*
+Strongly connected components of a directed graph on dense ids, with the condensation DAG
+Components are numbered in reverse topological order: every edge of dag goes from a higher
+component id to a lower one. The weight of an edge of dag is the number of input edges it
+stands for
+*/
+struct condensation {
+    std::vector<std::size_t> component;
+    util::csr_graph<std::size_t> dag;
 
-    std::vector<Vertex> vertices = src.vertices();
-    for (const Vertex& v : vertices)
-        visited[v] = false;
-
-    for (auto it = visited.cbegin(); it != visited.cend();
-         it = std::find_if(it, visited.cend(),
-                           [](const std::pair<Vertex, bool>& val) { return !val.second; })) {
-        const Vertex& start = it->first;
-        uint32_t num_children_of_root = 0;
-
-        depth_first(
-          src, start,
-          [&current_dfs_num, &search_number, &low, &visited](const Vertex& curr) {
-              // on visit, we simply assign a DFS number and base low number
-              search_number[curr] = low[curr] = current_dfs_num++;
-              visited[curr] = true;
+    std::size_t size() const noexcept { return dag.order(); }
+};
+
+// Build the condensation DAG of a graph given the component of every vertex
+template<typename EdgeWeight>
+static util::csr_graph<std::size_t>
+  condensation_dag(const util::csr_graph<EdgeWeight>& input,
+                   const std::vector<std::size_t>& component, std::size_t num_components) {
+    const std::size_t NONE = -1;
+    // members of each component, by counting sort
+    std::vector<std::size_t> member_offsets(num_components + 1, 0), members(input.order());
+    for (std::size_t c : component)
+        ++member_offsets[c + 1];
+    for (std::size_t c = 0; c < num_components; ++c)
+        member_offsets[c + 1] += member_offsets[c];
+    std::vector<std::size_t> position(member_offsets.begin(), member_offsets.end() - 1);
+    for (std::size_t v = 0; v < input.order(); ++v)
+        members[position[component[v]]++] = v;
+
+    util::csr_graph<std::size_t> dag;
+    dag.offsets.reserve(num_components + 1);
+    dag.offsets.push_back(0);
+    std::vector<std::size_t> last_source(num_components, NONE), slot(num_components);
+    for (std::size_t c = 0; c < num_components; ++c) {
+        for (std::size_t i = member_offsets[c]; i < member_offsets[c + 1]; ++i)
+            for (std::size_t j = input.offsets[members[i]]; j < input.offsets[members[i] + 1];
+                 ++j) {
+                std::size_t d = component[input.targets[j]];
+                if (d == c)
+                    continue;
+                if (last_source[d] != c) {
+                    last_source[d] = c;
+                    slot[d] = dag.targets.size();
+                    dag.targets.push_back(d);
+                    dag.weights.push_back(0);
+                }
+                ++dag.weights[slot[d]];
+            }
+        dag.offsets.push_back(dag.targets.size());
+    }
+    return dag;
+}
+
+/*
+Tarjan's algorithm on the vertices for which in_set holds, using depth_first_visit
+Vertices outside the set are ignored; each component found is numbered by next_id()
+low and on_stack are indexed by vertex and only touched for vertices in the set
+*/
+template<typename EdgeWeight, typename Predicate, typename IdSource>
+static void Tarjan_helper(const util::csr_graph<EdgeWeight>& input,
+                          const std::vector<std::size_t>& vertices, Predicate in_set,
+                          IdSource next_id, std::vector<std::size_t>& component,
+                          depth_first_state& state, std::vector<std::size_t>& low,
+                          std::vector<char>& on_stack) {
+    for (std::size_t v : vertices)
+        state.reset(v);
+
+    std::vector<std::size_t> component_stack;
+    for (std::size_t root : vertices) {
+        if (state.visited(root))
+            continue;
+
+        depth_first_visit(
+          input, root, state,
+          [&](std::size_t v) {
+              low[v] = state.discovered[v];
+              on_stack[v] = true;
+              component_stack.push_back(v);
           },
-          [&src, &search_number, &low, &result, &num_children_of_root,
-           &start](const Vertex& parent, const Vertex& child) {
-              if (parent == start) {
-                  // root is articulation point if it has multiple children
-                  ++num_children_of_root;
-              } else {
-                  // calculate low value of DFS for child (min low of children
-                  // currently stored)
-                  std::list<Vertex> neighbors = src.neighbors(child);
-                  uint32_t& low_ref = low[child];
-                  for (const Vertex& v : neighbors) {
-                      if (low_ref > search_number[v])
-                          low_ref = search_number[v];
-                  }
-
-                  // condition for biconnectivity
-                  if (low_ref == search_number[parent]) {
-                      result.insert(parent);
-                  }
-
-                  // update low value of parent
-                  if (low_ref < low[parent])
-                      low[parent] = low_ref;
+          [&](std::size_t v, std::size_t w, dfs_edge kind) {
+              if (!in_set(w))
+                  return false;
+              // edges to finished components (cross edges) do not count
+              if (kind != dfs_edge::tree && on_stack[w])
+                  low[v] = std::min(low[v], state.discovered[w]);
+              return true;
+          },
+          [&](std::size_t parent, std::size_t v) {
+              // break off a component if v is its root
+              if (low[v] == state.discovered[v]) {
+                  std::size_t id = next_id(), w;
+                  do {
+                      w = component_stack.back();
+                      component_stack.pop_back();
+                      on_stack[w] = false;
+                      component[w] = id;
+                  } while (w != v);
               }
+              if (parent != depth_first_state::NONE)
+                  low[parent] = std::min(low[parent], low[v]);
           });
-
-        // determining if the root of DFS tree is an articulation point
-        if (num_children_of_root > 1) {
-            result.insert(start);
-        }
     }
-
-    return result;
 }
 
 /*
-Find all strongly connected components
+Strongly connected components and condensation DAG of a directed graph in CSR form
+
+num_threads = 1: Tarjan's algorithm with an explicit stack
 Robert Tarjan
 Depth-First Search and Linear Graph Algorithms
 (1972) doi:10.1137/0201010
 Θ(V+E)
+
+Otherwise, on num_threads threads (0: all hardware threads): vertices with no incoming or no
+outgoing edges are trimmed, then forward-backward decomposition: the vertices both reachable
+from and reaching a pivot form its component, and the three remaining parts are independent
+subproblems, solved concurrently. Small subproblems fall back to Tarjan's algorithm
+Lisa Fleischer, Bruce Hendrickson, Ali Pınar
+On identifying strongly connected components in parallel
+(2000) doi:10.1007/3-540-45591-4_68
+William McLendon III, Bruce Hendrickson, Steven Plimpton, Lawrence Rauchwerger
+Finding strongly connected components in distributed graphs
+(2005) doi:10.1016/j.jpdc.2005.03.007
+O(E log V) expected work
 */
-template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
-std::list<std::unordered_set<Vertex, Args...>> strongly_connected_components(
-  const graph::graph<Vertex, true, Weighted, EdgeWeight, Args...>& src) {
-    std::unordered_map<Vertex, bool, Args...> finished;
-    std::unordered_map<Vertex, uint32_t, Args...> search_number, low;
-    uint32_t current_num = 0;
-    std::list<std::unordered_set<Vertex, Args...>> result;
-    std::unordered_map<Vertex, std::unordered_set<Vertex, Args...>, Args...> component;
+template<typename EdgeWeight>
+condensation strongly_connected_condensation(const util::csr_graph<EdgeWeight>& input,
+                                             unsigned num_threads = 1) {
+    std::size_t n = input.order();
+    condensation result;
+    result.component.assign(n, 0);
+    std::vector<std::size_t> low(n);
+    std::vector<char> on_stack(n, false);
 
-    if (src.order() == 0)
+    if (util::thread_count(num_threads) == 1) {
+        std::vector<std::size_t> vertices(n);
+        std::iota(vertices.begin(), vertices.end(), 0);
+        std::size_t num_components = 0;
+        depth_first_state state(n);
+        Tarjan_helper(
+          input, vertices, [](std::size_t) { return true; },
+          [&num_components]() { return num_components++; }, result.component, state, low,
+          on_stack);
+        result.dag = condensation_dag(input, result.component, num_components);
         return result;
+    }
 
-    std::vector<Vertex> vertices = src.vertices();
-    for (Vertex& v : vertices)
-        finished[v] = false;
+    const std::size_t SERIAL_THRESHOLD = 4096;
+    const std::size_t DONE = -1;
+    util::csr_graph<EdgeWeight> reverse = util::transpose(input);
+    std::atomic<std::size_t> next_component(0), next_color(1);
 
-    depth_first_forest(
-      src, src.vertices().front(),
-      [&current_num, &search_number, &low, &component](const Vertex& curr) {
-          search_number[curr] = low[curr] = current_num++;
-          component[curr].insert(curr);
-      },
-      [&component, &finished, &low, &result, &search_number, &src](const Vertex& parent,
-                                                                   const Vertex& child) {
-          // calculate low value for child (stored min low value of children)
-          // Do not consider children that have already been placed in an SCC (search tree cross
-          // edge)
-          std::list<Vertex> neighbors = src.neighbors(child);
-          for (const Vertex& v : neighbors) {
-              if (!finished[v] && (low[child] > search_number[v]))
-                  low[child] = search_number[v];
-          }
-
-          // break off SCC if found
-          if (low[child] == search_number[child]) {
-              std::unordered_set<Vertex, Args...>& toAdd = component[child];
-              for (const Vertex& member : toAdd)
-                  finished[member] = true;
-              result.push_back(std::move(toAdd));
-          }
-
-          // if not SCC, parent must be part of true SCC
-          if (!finished[child]) {
-              component[parent].merge(std::move(component[child]));
-          }
-
-          // update low value of parent
-          if (low[child] < low[parent])
-              low[parent] = low[child];
-      },
-      [&component, &result, &finished](const Vertex& root) {
-          // Handle root
-          std::unordered_set<Vertex, Args...>& toAdd = component[root];
-          for (const Vertex& member : toAdd)
-              finished[member] = true;
-          result.push_back(toAdd);
-      });
+    // trim: peel vertices without incoming or outgoing edges, each its own component
+    std::vector<std::size_t> in_degree(n), out_degree(n), peel;
+    for (std::size_t v = 0; v < n; ++v) {
+        in_degree[v] = reverse.degree(v);
+        out_degree[v] = input.degree(v);
+        if (in_degree[v] == 0 || out_degree[v] == 0)
+            peel.push_back(v);
+    }
+    std::vector<char> trimmed(n, false);
+    while (!peel.empty()) {
+        std::size_t v = peel.back();
+        peel.pop_back();
+        if (trimmed[v])
+            continue;
+        trimmed[v] = true;
+        result.component[v] = next_component++;
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            if (--in_degree[input.targets[j]] == 0)
+                peel.push_back(input.targets[j]);
+        for (std::size_t j = reverse.offsets[v]; j < reverse.offsets[v + 1]; ++j)
+            if (--out_degree[reverse.targets[j]] == 0)
+                peel.push_back(reverse.targets[j]);
+    }
+
+    // every open subproblem is a color class; vertices already assigned have color DONE
+    std::vector<std::atomic<std::size_t>> color(n);
+    std::deque<std::pair<std::size_t, std::vector<std::size_t>>> tasks(1);
+    tasks.front().first = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+        color[v].store(trimmed[v] ? DONE : 0, std::memory_order_relaxed);
+        if (!trimmed[v])
+            tasks.front().second.push_back(v);
+    }
+    std::size_t pending = 1;
+    std::mutex task_lock;
+    std::condition_variable task_ready;
+
+    // each thread keeps its own search state, used only on the vertices of its own subproblems
+    auto solve = [&](std::size_t task_color, std::vector<std::size_t>& vertices,
+                     std::vector<std::pair<std::size_t, std::vector<std::size_t>>>& subtasks,
+                     std::unique_ptr<depth_first_state>& state) {
+        auto has_color = [&color](std::size_t v, std::size_t c) {
+            return color[v].load(std::memory_order_relaxed) == c;
+        };
+        if (vertices.size() < SERIAL_THRESHOLD) {
+            if (!state)
+                state = std::make_unique<depth_first_state>(n);
+            Tarjan_helper(
+              input, vertices, [&](std::size_t v) { return has_color(v, task_color); },
+              [&next_component]() { return next_component++; }, result.component, *state, low,
+              on_stack);
+            for (std::size_t v : vertices)
+                color[v].store(DONE, std::memory_order_relaxed);
+            return;
+        }
 
+        // forward closure of the pivot gets color forward, backward closure within either color
+        // gets backward, or DONE if also forward (the pivot's component)
+        std::size_t pivot = vertices[vertices.size() / 2];
+        std::size_t forward = next_color++, backward = next_color++, id = next_component++;
+        std::vector<std::size_t> queue(1, pivot);
+        color[pivot].store(forward, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < queue.size(); ++i)
+            for (std::size_t j = input.offsets[queue[i]]; j < input.offsets[queue[i] + 1]; ++j)
+                if (has_color(input.targets[j], task_color)) {
+                    color[input.targets[j]].store(forward, std::memory_order_relaxed);
+                    queue.push_back(input.targets[j]);
+                }
+
+        queue.assign(1, pivot);
+        color[pivot].store(DONE, std::memory_order_relaxed);
+        result.component[pivot] = id;
+        for (std::size_t i = 0; i < queue.size(); ++i)
+            for (std::size_t j = reverse.offsets[queue[i]]; j < reverse.offsets[queue[i] + 1];
+                 ++j) {
+                std::size_t w = reverse.targets[j];
+                if (has_color(w, forward)) {
+                    color[w].store(DONE, std::memory_order_relaxed);
+                    result.component[w] = id;
+                    queue.push_back(w);
+                } else if (has_color(w, task_color)) {
+                    color[w].store(backward, std::memory_order_relaxed);
+                    queue.push_back(w);
+                }
+            }
+
+        std::size_t remaining = next_color++;
+        std::vector<std::size_t> parts[3];
+        for (std::size_t v : vertices) {
+            std::size_t c = color[v].load(std::memory_order_relaxed);
+            if (c == forward)
+                parts[0].push_back(v);
+            else if (c == backward)
+                parts[1].push_back(v);
+            else if (c == task_color) {
+                color[v].store(remaining, std::memory_order_relaxed);
+                parts[2].push_back(v);
+            }
+        }
+        std::size_t part_colors[3] = {forward, backward, remaining};
+        for (std::size_t k = 0; k < 3; ++k)
+            if (!parts[k].empty())
+                subtasks.emplace_back(part_colors[k], std::move(parts[k]));
+    };
+
+    util::parallel_run(num_threads, [&](unsigned) {
+        std::vector<std::pair<std::size_t, std::vector<std::size_t>>> subtasks;
+        std::unique_ptr<depth_first_state> state;
+        while (true) {
+            std::pair<std::size_t, std::vector<std::size_t>> task;
+            {
+                std::unique_lock<std::mutex> lock(task_lock);
+                task_ready.wait(lock, [&]() { return !tasks.empty() || pending == 0; });
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            subtasks.clear();
+            solve(task.first, task.second, subtasks, state);
+
+            {
+                std::lock_guard<std::mutex> lock(task_lock);
+                pending += subtasks.size();
+                --pending;
+                for (std::pair<std::size_t, std::vector<std::size_t>>& subtask : subtasks)
+                    tasks.push_back(std::move(subtask));
+            }
+            task_ready.notify_all();
+        }
+    });
+
+    // renumber into reverse topological order of the condensation
+    std::size_t num_components = next_component.load();
+    util::csr_graph<std::size_t> dag = condensation_dag(input, result.component, num_components);
+    std::vector<std::size_t> in_dag(num_components, 0), order, rank(num_components);
+    for (std::size_t d : dag.targets)
+        ++in_dag[d];
+    for (std::size_t c = 0; c < num_components; ++c)
+        if (in_dag[c] == 0)
+            order.push_back(c);
+    for (std::size_t i = 0; i < order.size(); ++i)
+        for (std::size_t j = dag.offsets[order[i]]; j < dag.offsets[order[i] + 1]; ++j)
+            if (--in_dag[dag.targets[j]] == 0)
+                order.push_back(dag.targets[j]);
+    for (std::size_t i = 0; i < num_components; ++i)
+        rank[order[i]] = num_components - 1 - i;
+    for (std::size_t& c : result.component)
+        c = rank[c];
+
+    result.dag = condensation_dag(input, result.component, num_components);
     return result;
 }
+
+/*
+Find all strongly connected components, in the order Tarjan's algorithm completes them
+(reverse topological order)
+num_threads = 1 (default) runs Tarjan's algorithm, anything else the parallel forward-backward
+decomposition; see strongly_connected_condensation
+*/
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::list<std::unordered_set<Vertex, Args...>> strongly_connected_components(
+  const graph::graph<Vertex, true, Weighted, EdgeWeight, Args...>& src,
+  unsigned num_threads = 1) {
+    std::vector<Vertex> vertices = src.vertices();
+    condensation scc = strongly_connected_condensation(util::get_csr_rep(src), num_threads);
+
+    std::vector<std::unordered_set<Vertex, Args...>> components(scc.size());
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        components[scc.component[v]].insert(vertices[v]);
+    return std::list<std::unordered_set<Vertex, Args...>>(
+      std::make_move_iterator(components.begin()), std::make_move_iterator(components.end()));
+}
 } // namespace graph_alg
 
 #endif // GRAPH_COMPONENTS_H
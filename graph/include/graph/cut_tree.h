@@ -0,0 +1,197 @@
+#ifndef GRAPH_CUT_TREE_H
+#define GRAPH_CUT_TREE_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+#include "max_flow_min_cut.h"
+#include "path.h"
+
+namespace graph_alg {
+/*
+ * Gomory-Hu tree of a single connected component, given as an exposed adjacency list
+ * Returns (parent, weight): vertex 0 is the root, and every other vertex i has a tree edge to
+ * parent[i] of cost weight[i]
+ *
+ * Path finder is any of the Ford-Fulkerson helpers (Edmonds_Karp_helper, Dinic_helper, ...)
+ *
+ * Dan Gusfield
+ * Very simple methods for all pairs network flow analysis
+ * (1990) doi:10.1137/0219009
+ * V - 1 maximum flow computations, no graph contraction
+ */
+template<typename EdgeWeight, typename Function>
+std::pair<std::vector<std::size_t>, std::vector<EdgeWeight>>
+  Gusfield_cut_tree(exp_graph<EdgeWeight>& input, Function path_finder) {
+    static const EdgeWeight zero = zero_check<EdgeWeight>::zero;
+    zero_check<EdgeWeight> is_zero;
+
+    std::size_t n = input.size();
+    std::vector<std::size_t> parent(n, 0);
+    std::vector<EdgeWeight> weight(n, zero);
+
+    std::vector<EdgeWeight> residual(n, zero);
+    std::vector<bool> source_side(n);
+    for (std::size_t s = 1; s < n; ++s) {
+        std::size_t t = parent[s];
+        exp_graph<EdgeWeight> flow = Ford_Fulkerson(input, s, t, path_finder);
+
+        exp_graph<EdgeWeight> flow_in(n);
+        for (std::size_t u = 0; u < n; ++u)
+            for (const std::pair<std::size_t, EdgeWeight>& e : flow[u])
+                flow_in[e.first].emplace_back(u, e.second);
+
+        EdgeWeight value = zero;
+        for (const std::pair<std::size_t, EdgeWeight>& e : flow[s])
+            value += e.second;
+        for (const std::pair<std::size_t, EdgeWeight>& e : flow_in[s])
+            value -= e.second;
+
+        // Source side of the cut: everything reachable from s in the residual graph
+        std::fill(source_side.begin(), source_side.end(), false);
+        std::vector<std::size_t> frontier(1, s);
+        source_side[s] = true;
+        while (!frontier.empty()) {
+            std::size_t u = frontier.back();
+            frontier.pop_back();
+
+            for (const std::pair<std::size_t, EdgeWeight>& e : input[u])
+                residual[e.first] += e.second;
+            for (const std::pair<std::size_t, EdgeWeight>& e : flow[u])
+                residual[e.first] -= e.second;
+            for (const std::pair<std::size_t, EdgeWeight>& e : flow_in[u])
+                residual[e.first] += e.second;
+
+            // any residual capacity comes from a capacity or a reversible flow
+            for (const exp_graph<EdgeWeight>* list : {&input, &flow_in})
+                for (const std::pair<std::size_t, EdgeWeight>& e : (*list)[u])
+                    if (!source_side[e.first] && residual[e.first] > zero &&
+                        !is_zero(residual[e.first])) {
+                        source_side[e.first] = true;
+                        frontier.push_back(e.first);
+                    }
+
+            for (const exp_graph<EdgeWeight>* list : {&input, &flow, &flow_in})
+                for (const std::pair<std::size_t, EdgeWeight>& e : (*list)[u])
+                    residual[e.first] = zero;
+        }
+
+        weight[s] = value;
+        for (std::size_t i = 0; i < n; ++i)
+            if (i != s && source_side[i] && parent[i] == t)
+                parent[i] = s;
+        if (source_side[parent[t]]) {
+            parent[s] = parent[t];
+            parent[t] = s;
+            weight[s] = weight[t];
+            weight[t] = value;
+        }
+    }
+
+    return std::make_pair(std::move(parent), std::move(weight));
+}
+
+/*
+ * Gomory-Hu tree: a weighted tree on the vertices of an undirected capacity graph such that the
+ * minimum cut between any u and v equals the lightest edge on the tree path between them
+ * Disconnected components are joined to each other with edges of cost 0
+ *
+ * Ralph E. Gomory, Te Chiang Hu
+ * Multi-terminal network flows
+ * (1961) doi:10.1137/0109047
+ *
+ * Components are independent, and are solved concurrently on num_threads threads (0: all
+ * hardware threads)
+ * V - 1 maximum flow computations
+ */
+template<typename Vertex, typename EdgeWeight, typename Function, typename... Args>
+graph::graph<Vertex, false, true, EdgeWeight, Args...>
+  Gomory_Hu_tree(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& input,
+                 Function path_finder, unsigned num_threads = 1) {
+    exp_graph<EdgeWeight> full = util::get_list_rep(input);
+    std::vector<Vertex> vertices = input.vertices();
+    std::size_t n = vertices.size();
+
+    // Split into connected components, relabeling each to 0 - (k-1)
+    std::vector<std::size_t> local_id(n, n);
+    std::vector<std::vector<std::size_t>> components;
+    for (std::size_t root = 0; root < n; ++root) {
+        if (local_id[root] != n)
+            continue;
+        std::vector<std::size_t> members(1, root);
+        local_id[root] = 0;
+        for (std::size_t i = 0; i < members.size(); ++i)
+            for (const std::pair<std::size_t, EdgeWeight>& e : full[members[i]])
+                if (local_id[e.first] == n) {
+                    local_id[e.first] = members.size();
+                    members.push_back(e.first);
+                }
+        components.push_back(std::move(members));
+    }
+
+    // largest components first, for better load balancing
+    std::sort(components.begin(), components.end(),
+              [](const std::vector<std::size_t>& x, const std::vector<std::size_t>& y) {
+                  return x.size() > y.size();
+              });
+
+    std::vector<std::pair<std::vector<std::size_t>, std::vector<EdgeWeight>>> trees(
+      components.size());
+    util::parallel_for(0, components.size(), num_threads, [&](unsigned, std::size_t c) {
+        const std::vector<std::size_t>& members = components[c];
+        exp_graph<EdgeWeight> local(members.size());
+        for (std::size_t i = 0; i < members.size(); ++i)
+            for (const std::pair<std::size_t, EdgeWeight>& e : full[members[i]])
+                local[i].emplace_back(local_id[e.first], e.second);
+        trees[c] = Gusfield_cut_tree(local, path_finder);
+    });
+
+    graph::graph<Vertex, false, true, EdgeWeight, Args...> result;
+    for (const Vertex& v : vertices)
+        result.add_vertex(v);
+    for (std::size_t c = 0; c < components.size(); ++c) {
+        const std::vector<std::size_t>& members = components[c];
+        for (std::size_t i = 1; i < members.size(); ++i)
+            result.force_add(vertices[members[i]], vertices[members[trees[c].first[i]]],
+                             trees[c].second[i]);
+        if (c != 0)
+            result.force_add(vertices[members.front()], vertices[components.front().front()],
+                             EdgeWeight());
+    }
+
+    return result;
+}
+
+template<typename Vertex, typename EdgeWeight, typename... Args>
+graph::graph<Vertex, false, true, EdgeWeight, Args...>
+  Gomory_Hu_tree(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& input,
+                 unsigned num_threads = 1) {
+    return Gomory_Hu_tree(input, Dinic_helper<EdgeWeight>, num_threads);
+}
+
+/*
+ * Minimum cut value between u and v, read off a Gomory-Hu tree
+ * Θ(V) per query instead of a maximum flow computation
+ */
+template<typename Vertex, typename EdgeWeight, typename... Args>
+EdgeWeight Gomory_Hu_min_cut(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& tree,
+                             const Vertex& u, const Vertex& v) {
+    if (tree.get_translation().key_eq()(u, v))
+        throw std::invalid_argument("Cut endpoints must differ");
+
+    std::list<Vertex> path = least_edges_path(tree, u, v);
+    EdgeWeight result = tree.edge_cost(u, path.front());
+    for (auto it = path.begin(), next = std::next(path.begin()); next != path.end(); ++it, ++next)
+        result = std::min(result, tree.edge_cost(*it, *next));
+    return result;
+}
+} // namespace graph_alg
+
+#endif // GRAPH_CUT_TREE_H
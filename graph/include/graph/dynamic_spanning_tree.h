@@ -0,0 +1,320 @@
+#ifndef GRAPH_DYNAMIC_SPANNING_TREE_H
+#define GRAPH_DYNAMIC_SPANNING_TREE_H
+
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <structures/graph.h>
+#include <structures/link_cut_tree.h>
+
+namespace graph_alg {
+/*
+ * Minimum spanning forest of an undirected graph that changes over time
+ *
+ * The forest is kept in a link-cut tree in which every forest edge is a node of its own, so
+ * the heaviest edge on a forest path is a path maximum query. Inserting an edge or lowering a
+ * weight swaps out the heaviest edge of the cycle it closes (cycle property); deleting a forest
+ * edge or raising its weight looks for the lightest non-forest edge reconnecting the two halves
+ * (cut property). Forest adjacency lists are searched from both halves at once, one edge at a time,
+ * until the smaller half is exhausted; only the non-forest edges of that half are then scanned,
+ * lightest first per vertex
+ *
+ * Daniel Sleator, Robert Tarjan
+ * A data structure for dynamic trees
+ * (1983) doi:10.1016/0022-0000(83)90006-5
+ *
+ * Insertion, weight decrease, non-forest deletion: O(log V) amortized
+ * Forest edge deletion, forest weight increase: O((s + k) log V), s the number of vertices of the
+ * smaller half and k the number of its non-forest edges lighter than the replacement or internal
+ * to it, each of which is scanned once
+ * That is Θ((V + E) log V) in the worst case, e.g. cutting the middle of a long path whose halves
+ * carry many chords, and not amortized away: this is not the leveled Holm-de Lichtenberg-Thorup
+ * structure, so a failed search leaves nothing behind to pay for the next one
+ */
+template<typename Vertex, typename EdgeWeight = double, typename Hash = std::hash<Vertex>,
+         typename KeyEqual = std::equal_to<Vertex>>
+class dynamic_spanning_forest {
+    public:
+    typedef graph::graph<Vertex, false, true, EdgeWeight, Hash, KeyEqual> graph_type;
+
+    dynamic_spanning_forest() : _total(), _tree(), _edges() {}
+
+    // Start from every vertex and edge of a graph
+    // O(E log V)
+    explicit dynamic_spanning_forest(const graph_type& input) : dynamic_spanning_forest() {
+        for (const Vertex& v : input.vertices())
+            add_vertex(v);
+        for (const Vertex& u : input.vertices())
+            for (const std::pair<Vertex, EdgeWeight>& e : input.edges(u))
+                if (_translation.at(u) < _translation.at(e.first))
+                    insert_edge(u, e.first, e.second);
+    }
+
+    // Throws std::invalid_argument if the vertex already exists
+    void add_vertex(const Vertex& v) {
+        if (_translation.find(v) != _translation.end())
+            throw std::invalid_argument("Vertex already exists");
+        _translation.emplace(v, _vertices.size());
+        _vertices.push_back(v);
+        _vertex_node.push_back(_tree.add_node(std::numeric_limits<EdgeWeight>::lowest()));
+        _forest_neighbors.emplace_back();
+        _non_forest.emplace_back();
+        _side.push_back(0);
+    }
+
+    // Throws std::invalid_argument on a self-loop or an existing edge
+    void insert_edge(const Vertex& u, const Vertex& v, EdgeWeight weight) {
+        edge_key key = _key(u, v);
+        if (key.first == key.second)
+            throw std::invalid_argument("Self-loops are not supported");
+        if (_edges.find(key) != _edges.end())
+            throw std::invalid_argument("Edge already exists");
+        _edges.emplace(key, edge_data{weight, NONE});
+        _add_to_forest(key);
+    }
+
+    // Throws std::invalid_argument if there is no such edge
+    void remove_edge(const Vertex& u, const Vertex& v) {
+        edge_key key = _key(u, v);
+        typename std::map<edge_key, edge_data>::iterator it = _find(key);
+        if (it->second.node == NONE) {
+            _from_non_forest(key);
+            _edges.erase(it);
+            return;
+        }
+
+        _cut(key);
+        _edges.erase(it);
+        _reconnect(key, nullptr);
+    }
+
+    // Throws std::invalid_argument if there is no such edge
+    void set_weight(const Vertex& u, const Vertex& v, EdgeWeight weight) {
+        edge_key key = _key(u, v);
+        edge_data& data = _find(key)->second;
+        if (data.node == NONE) {
+            _from_non_forest(key);
+            data.weight = weight;
+            _add_to_forest(key);
+        } else if (!(data.weight < weight)) {
+            // a lighter forest edge stays in the forest
+            _total += weight - data.weight;
+            data.weight = weight;
+            _tree.set_value(data.node, weight);
+        } else {
+            _cut(key);
+            data.weight = weight;
+            _reconnect(key, &weight);
+        }
+    }
+
+    bool has_edge(const Vertex& u, const Vertex& v) const {
+        return _edges.find(_key(u, v)) != _edges.end();
+    }
+
+    // Whether the edge u-v is currently part of the minimum spanning forest
+    bool in_forest(const Vertex& u, const Vertex& v) const {
+        typename std::map<edge_key, edge_data>::const_iterator it = _edges.find(_key(u, v));
+        return it != _edges.end() && it->second.node != NONE;
+    }
+
+    // O(log V) amortized
+    bool connected(const Vertex& u, const Vertex& v) {
+        return _tree.connected(_vertex_node[_translation.at(u)], _vertex_node[_translation.at(v)]);
+    }
+
+    EdgeWeight total_weight() const noexcept { return _total; }
+
+    // Copy of the current minimum spanning forest
+    // Θ(V + E)
+    graph_type forest() const {
+        graph_type result;
+        for (const Vertex& v : _vertices)
+            result.add_vertex(v);
+        for (const std::pair<const edge_key, edge_data>& e : _edges)
+            if (e.second.node != NONE)
+                result.force_add(_vertices[e.first.first], _vertices[e.first.second],
+                                 e.second.weight);
+        return result;
+    }
+
+    private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+    typedef std::pair<std::size_t, std::size_t> edge_key; // vertex ids, smaller first
+    typedef std::tuple<EdgeWeight, std::size_t, std::size_t> weighted_key;
+
+    struct edge_data {
+        EdgeWeight weight;
+        std::size_t node; // link-cut tree node if in the forest, NONE otherwise
+    };
+
+    edge_key _key(const Vertex& u, const Vertex& v) const {
+        std::size_t a = _translation.at(u), b = _translation.at(v);
+        return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+    }
+
+    typename std::map<edge_key, edge_data>::iterator _find(const edge_key& key) {
+        typename std::map<edge_key, edge_data>::iterator it = _edges.find(key);
+        if (it == _edges.end())
+            throw std::invalid_argument("No such edge");
+        return it;
+    }
+
+    void _link(const edge_key& key) {
+        edge_data& data = _edges.at(key);
+        if (_free_nodes.empty()) {
+            data.node = _tree.add_node(data.weight);
+            _node_edge.resize(_tree.size());
+        } else {
+            data.node = _free_nodes.back();
+            _free_nodes.pop_back();
+            _tree.set_value(data.node, data.weight);
+        }
+        _node_edge[data.node] = key;
+        _tree.link(data.node, _vertex_node[key.first]);
+        _tree.link(data.node, _vertex_node[key.second]);
+        _forest_neighbors[key.first].insert(key.second);
+        _forest_neighbors[key.second].insert(key.first);
+        _total += data.weight;
+    }
+
+    void _cut(const edge_key& key) {
+        edge_data& data = _edges.at(key);
+        _tree.cut(data.node, _vertex_node[key.first]);
+        _tree.cut(data.node, _vertex_node[key.second]);
+        _forest_neighbors[key.first].erase(key.second);
+        _forest_neighbors[key.second].erase(key.first);
+        _free_nodes.push_back(data.node);
+        data.node = NONE;
+        _total -= data.weight;
+    }
+
+    void _to_non_forest(const edge_key& key) {
+        EdgeWeight weight = _edges.at(key).weight;
+        _non_forest[key.first].emplace(weight, key.second);
+        _non_forest[key.second].emplace(weight, key.first);
+    }
+
+    void _from_non_forest(const edge_key& key) {
+        EdgeWeight weight = _edges.at(key).weight;
+        _non_forest[key.first].erase(std::make_pair(weight, key.second));
+        _non_forest[key.second].erase(std::make_pair(weight, key.first));
+    }
+
+    // Vertices of the smaller of the two forest trees holding u and v, found by depth-first
+    // searches from both that advance one edge each in turn: Θ(size of the smaller tree) steps
+    std::vector<std::size_t> _smaller_tree(std::size_t u, std::size_t v) const {
+        typedef std::set<std::size_t>::const_iterator neighbor_iterator;
+        struct search {
+            std::vector<std::size_t> reached;
+            std::vector<std::tuple<std::size_t, std::size_t, neighbor_iterator>> stack;
+        } searches[2];
+        for (int i = 0; i < 2; ++i) {
+            std::size_t start = i == 0 ? u : v;
+            searches[i].reached.push_back(start);
+            searches[i].stack.emplace_back(start, NONE, _forest_neighbors[start].begin());
+        }
+
+        for (int i = 0;; i = 1 - i) {
+            search& s = searches[i];
+            if (s.stack.empty())
+                return s.reached;
+            auto& [x, parent, next] = s.stack.back();
+            if (next == _forest_neighbors[x].end()) {
+                s.stack.pop_back();
+                continue;
+            }
+            std::size_t y = *next++;
+            if (y != parent) {
+                s.reached.push_back(y);
+                s.stack.emplace_back(y, x, _forest_neighbors[y].begin());
+            }
+        }
+    }
+
+    // Cycle property: an edge joins the forest if it connects two trees, or if it is lighter than
+    // the heaviest edge on the forest path between its endpoints
+    void _add_to_forest(const edge_key& key) {
+        std::size_t u = _vertex_node[key.first], v = _vertex_node[key.second];
+        if (!_tree.connected(u, v)) {
+            _link(key);
+            return;
+        }
+
+        std::size_t heaviest = _tree.path_max(u, v);
+        if (_edges.at(key).weight < _tree.value(heaviest)) {
+            edge_key replaced = _node_edge[heaviest];
+            _cut(replaced);
+            _to_non_forest(replaced);
+            _link(key);
+        } else {
+            _to_non_forest(key);
+        }
+    }
+
+    // Cut property: after the forest edge removed_key was cut, reconnect its endpoints with the
+    // lightest non-forest edge between the two halves
+    // If the edge still exists with a new weight (pointed to by candidate), it competes as well
+    void _reconnect(const edge_key& removed_key, const EdgeWeight* candidate) {
+        std::vector<std::size_t> smaller = _smaller_tree(removed_key.first, removed_key.second);
+        ++_stamp;
+        for (std::size_t x : smaller)
+            _side[x] = _stamp;
+
+        // every non-forest edge had both endpoints in one tree before the cut, so any edge leaving
+        // the smaller half reconnects it; ties are broken by (weight, smaller id, larger id)
+        bool found = false;
+        weighted_key best;
+        for (std::size_t x : smaller) {
+            for (const std::pair<EdgeWeight, std::size_t>& e : _non_forest[x]) {
+                if ((candidate != nullptr && !(e.first < *candidate)) ||
+                    (found && std::get<0>(best) < e.first))
+                    break;
+                if (_side[e.second] == _stamp)
+                    continue;
+                weighted_key crossing(e.first, std::min(x, e.second), std::max(x, e.second));
+                if (!found || crossing < best)
+                    best = crossing;
+                found = true;
+                break;
+            }
+        }
+
+        if (found) {
+            edge_key key(std::get<1>(best), std::get<2>(best));
+            _from_non_forest(key);
+            _link(key);
+            if (candidate != nullptr)
+                _to_non_forest(removed_key);
+        } else if (candidate != nullptr) {
+            _link(removed_key);
+        }
+    }
+
+    std::unordered_map<Vertex, std::size_t, Hash, KeyEqual> _translation;
+    std::vector<Vertex> _vertices;
+    std::vector<std::size_t> _vertex_node;
+    EdgeWeight _total;
+
+    link_cut_tree<EdgeWeight> _tree;
+    std::vector<edge_key> _node_edge; // forest edge of each edge node
+    std::vector<std::size_t> _free_nodes;
+    std::vector<std::set<std::size_t>> _forest_neighbors;
+
+    std::map<edge_key, edge_data> _edges;
+    std::vector<std::set<std::pair<EdgeWeight, std::size_t>>> _non_forest; // (weight, other end)
+
+    // _side[x] == _stamp for the vertices of the smaller half of the last forest edge cut
+    std::vector<std::size_t> _side;
+    std::size_t _stamp = 0;
+};
+} // namespace graph_alg
+
+#endif // GRAPH_DYNAMIC_SPANNING_TREE_H
@@ -1,133 +1,143 @@
 #ifndef GRAPH_ORDER_DIMENSION_H
 #define GRAPH_ORDER_DIMENSION_H
 
+#include <list>
+#include <stdexcept>
 #include <vector>
 
 #include <structures/graph.h>
 #include <structures/van_Emde_Boas_map.h>
 
+#include <util/exposed_graph.h>
+
+#include "closure.h"
+#include "orientation.h"
 #include "search.h"
 
 namespace graph_alg {
+// Realizer of a partial order on dense ids given by less(u, v): two linear extensions whose
+// intersection is the order, false if the order has dimension above 2
+// The incomparable pairs are oriented, transitively if they can be, and each extension adds that
+// orientation or its reverse to the order; the realizer is checked pair by pair instead of the
+// orientation
+template<typename Less>
+static bool two_dimensional_realizer(std::size_t n, Less less, std::vector<std::size_t>& first,
+                                     std::vector<std::size_t>& second) {
+    util::csr_graph<bool> incomparable;
+    incomparable.offsets.push_back(0);
+    for (std::size_t u = 0; u < n; ++u) {
+        for (std::size_t v = 0; v < n; ++v)
+            if (u != v && !less(u, v) && !less(v, u))
+                incomparable.targets.push_back(v);
+        incomparable.offsets.push_back(incomparable.targets.size());
+    }
+    incomparable.weights.assign(incomparable.size(), true);
+    modular_decomposition_tree tree;
+    std::vector<bool> forward;
+    modular_decomposition_helper(incomparable, tree, &forward, false);
+
+    for (bool reversed : {false, true}) {
+        util::csr_graph<bool> extension;
+        extension.offsets.push_back(0);
+        for (std::size_t u = 0; u < n; ++u) {
+            for (std::size_t v = 0; v < n; ++v)
+                if (u != v && less(u, v))
+                    extension.targets.push_back(v);
+            for (std::size_t j = incomparable.offsets[u]; j < incomparable.offsets[u + 1]; ++j)
+                if (forward[j] != reversed)
+                    extension.targets.push_back(incomparable.targets[j]);
+            extension.offsets.push_back(extension.targets.size());
+        }
+        extension.weights.assign(extension.size(), true);
+        try {
+            (reversed ? second : first) = Kahn_levels(extension).order;
+        } catch (const std::invalid_argument&) {
+            return false;
+        }
+    }
+
+    std::vector<std::size_t> first_position(n), second_position(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        first_position[first[i]] = i;
+        second_position[second[i]] = i;
+    }
+    for (std::size_t u = 0; u < n; ++u)
+        for (std::size_t v = 0; v < n; ++v)
+            if (u != v && less(u, v) != (first_position[u] < first_position[v] &&
+                                         second_position[u] < second_position[v]))
+                return false;
+    return true;
+}
+
+template<typename Vertex>
+static std::pair<std::list<Vertex>, std::list<Vertex>>
+  realizer_lists(const std::vector<Vertex>& vertices, const std::vector<std::size_t>& first,
+                 const std::vector<std::size_t>& second) {
+    std::pair<std::list<Vertex>, std::list<Vertex>> result;
+    for (std::size_t v : first)
+        result.first.push_back(vertices[v]);
+    for (std::size_t v : second)
+        result.second.push_back(vertices[v]);
+    return result;
+}
+
 /**
  * Find generators for a partial order of dimension 2, if they exist
  * Partial order is inputted as the transitive closure of a directed acyclic graph
+ * Throws std::domain_error if the dimension is above 2
  *
- * Jeremy Spinrad
- * Two Dimensional Partial Orders, 1982
- * O(n^2)
+ * The order has dimension at most 2 exactly when its incomparability graph is a comparability graph
+ * Ben Dushnik, Edwin Miller
+ * Partially ordered sets
+ * (1941) doi:10.2307/2371374
+ * Ross McConnell, Jeremy Spinrad
+ * Modular decomposition and transitive orientation
+ * (1999) doi:10.1016/S0012-365X(98)00319-7
+ * O(n^2 log n)
  */
 template<typename Vertex, bool Weighted, typename... Args>
 std::pair<std::list<Vertex>, std::list<Vertex>>
-  two_dimensional_order_generator_closure(const graph::graph<Vertex, true, Weighted, Args...>&);
+  two_dimensional_order_generator_closure(
+    const graph::graph<Vertex, true, Weighted, Args...>& input) {
+    auto closure = util::get_csr_rep(input);
+    std::size_t n = closure.order();
+    std::vector<bool> related(n * n, false);
+    for (std::size_t u = 0; u < n; ++u)
+        for (std::size_t j = closure.offsets[u]; j < closure.offsets[u + 1]; ++j)
+            related[u * n + closure.targets[j]] = true;
+
+    std::vector<std::size_t> first, second;
+    if (!two_dimensional_realizer(
+          n, [&related, n](std::size_t u, std::size_t v) { return related[u * n + v]; }, first,
+          second))
+        throw std::domain_error("Order dimension exceeds 2");
+    return realizer_lists(input.vertices(), first, second);
+}
 
 /**
  * Verify order dimension 2 and find generators if they exist
  * Partial order need not be given as a transitive closure
- * Calculates transitive closure in the process
+ * Calculates transitive closure in the process, 64 pairs to a word
+ * Throws std::invalid_argument if the graph has a cycle, std::domain_error if the dimension is
+ * above 2
  *
- * Tze-Heng Ma, Jeremy Spinrad
- * Transitive closure for restricted classes of partial orders
- * O(n^2)
+ * O(VE/64 + V^2 log V)
  */
 template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
 std::pair<std::list<Vertex>, std::list<Vertex>> two_dimensional_order_generator(
   const graph::graph<Vertex, true, Weighted, EdgeWeight, Args...>& input) {
-    std::vector<Vertex> top_order = topological_order(input);
-    std::pair<std::list<Vertex>, std::list<Vertex>> result;
-    if (input.order() == 0)
-        return result;
-    if (input.order() == 1) {
-        result.first.push_back(input.vertices().front());
-        result.second.push_back(input.vertices().front());
-        return result;
-    }
-    if (input.order() == 2) {
-        std::vector<Vertex> vertices = input.vertices();
-        if (input.has_edge(vertices.front(), vertices.back())) {
-            result.first.push_back(vertices.front());
-            result.first.push_back(vertices.back());
-            result.second = result.first;
-            return result;
-        }
-        if (input.has_edge(vertices.back(), vertices.front())) {
-            result.first.push_back(vertices.back());
-            result.first.push_back(vertices.front());
-            result.second = result.first;
-            return result;
-        }
-        result.first.push_back(vertices.front());
-        result.second.push_front(vertices.front());
-        result.first.push_back(vertices.back());
-        result.second.push_front(vertices.back());
-        return result;
-    }
-
-    // divide and conquer
-    std::pair<std::list<Vertex>, std::list<Vertex>> front_order = two_dimensional_order_generator(
-      input.generate_induced_subgraph(top_order.begin(), top_order.begin() + input.order() / 2));
-    std::pair<std::list<Vertex>, std::list<Vertex>> back_order = two_dimensional_order_generator(
-      input.generate_induced_subgraph(top_order.begin() + input.order() / 2, top_order.end()));
-
-    graph::graph<Vertex, true, false, Args...> closure(graph::adj_matrix);
-    for (const Vertex& v : input.vertices())
-        closure.add_vertex(v);
-
-    // Generate transitive closure of each part
-    for (const Vertex& v : front_order.first) {
-        auto second_it = std::find(front_order.second.begin(), front_order.second.end(), v);
-        for (auto it = second_it + 1; it != front_order.second.end(); ++it)
-            closure.force_add(v, *it);
-    }
-    for (const Vertex& v : back_order.first) {
-        auto second_it = std::find(back_order.second.begin(), back_order.second.end(), v);
-        for (auto it = second_it + 1; it != back_order.second.end(); ++it)
-            closure.force_add(v, *it);
-    }
-
-    // Generating transitive closure of cross edges
-    std::unordered_map<Vertex, std::size_t, Args...> second_order_map;
-    for (std::size_t i = 0; i < front_order.second.size(); ++i)
-        second_order_map[front_order.second[i]] = i;
-    for (std::size_t i = 0; i < back_order.second.size(); ++i)
-        second_order_map[front_order.second[i]] = i;
-
-    graph::graph<Vertex, true, Weighted, EdgeWeight, Args...> matrix_rep =
-      input.convert(graph::graph_type::adj_matrix);
-
-    for (const Vertex& v : front_order.first) {
-        // Forward sweep: find all (v, w) from (v,u) and (u, w) where u and w are in back_order
-        auto it =
-          std::find_if(back_order.first.begin(), back_order.first.end(),
-                       [&matrix_rep, &v](const Vertex& w) { return matrix_rep.has_edge(v, w); });
-        if (it != back_order.first.end()) {
-            std::size_t limit = second_order_map[*it];
-            for (++it; it != back_order.first.end(); ++it) {
-                if (matrix_rep.has_edge(v, *it) && second_order_map[*it] < limit)
-                    limit = second_order_map[*it];
-                else if (second_order_map[*it] > limit)
-                    matrix_rep.set_edge(v, *it);
-            }
-        }
-    }
-
-    for (const Vertex& v : back_order.first) {
-        // Backward sweep: find all (u,v) from (u,w) and (w,v) where u and w are in front_order
-        auto it =
-          std::find_if(front_order.first.rbegin(), front_order.first.rend(),
-                       [&matrix_rep, &v](const Vertex& u) { return matrix_rep.has_edge(u, v); });
-        if (it != front_order.first.rend()) {
-            std::size_t limit = second_order_map[*it];
-            for (++it; it != front_order.first.rend(); ++it) {
-                if (matrix_rep.has_edge(*it, v) && second_order_map[*it] > limit)
-                    limit = second_order_map[*it];
-                else if (second_order_map[*it] < limit)
-                    matrix_rep.set_edge(*it, v);
-            }
-        }
-    }
-
-    return two_dimensional_order_generator_closure(matrix_rep);
+    reachability_closure closure = bit_transitive_closure(util::get_csr_rep(input));
+    std::size_t n = input.order();
+    if (closure.scc.size() != n)
+        throw std::invalid_argument("Not DAG");
+
+    std::vector<std::size_t> first, second;
+    if (!two_dimensional_realizer(
+          n,
+          [&closure](std::size_t u, std::size_t v) { return u != v && closure.reaches(u, v); },
+          first, second))
+        throw std::domain_error("Order dimension exceeds 2");
+    return realizer_lists(input.vertices(), first, second);
 }
 
 template<typename It1, typename It2, typename It3, typename... Args>
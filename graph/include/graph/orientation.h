@@ -1,49 +1,617 @@
 #ifndef GRAPH_ALG_ORIENTATION_H
 #define GRAPH_ALG_ORIENTATION_H
 
-#include "search.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <structures/graph.h>
+#include <structures/partition_refinement.h>
+
+#include <util/exposed_graph.h>
 
 namespace graph_alg {
+/*
+ * Modular decomposition and transitive orientation
+ * Inputs are simple undirected graphs in CSR form (both directions of every edge stored)
+ * A module is a set of vertices that every vertex outside it sees either entirely or not at all;
+ * the strong modules, which overlap no other module, nest into a tree with the vertices as leaves
+ */
+
+/*
+ * Tree of the strong modules: nodes 0 - (n - 1) are the vertices, internal nodes follow
+ * The children of a parallel node are the components of its module, those of a series node the
+ * components of its complement; the children of a prime node are its maximal proper modules
+ */
+struct modular_decomposition_tree {
+    enum class node_type { vertex, parallel, series, prime };
+
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    std::vector<node_type> type;
+    std::vector<std::size_t> parent; // NONE for the root
+    std::vector<std::vector<std::size_t>> children;
+    std::size_t root = NONE;         // NONE for the empty graph
+
+    std::size_t size() const noexcept { return type.size(); }
+};
+
+/*
+ * Ordered vertex partition of a graph from the partition ({start}, rest): every class is split by
+ * the neighborhood of a pivot outside it, the neighbors moving to the end farther from the class
+ * of the pivot. After a split every vertex of the smaller side pivots, and one of the larger side
+ * Classes are ranges of one array, so a split costs time proportional to the neighbors moved
+ * On a prime comparability graph the classes end up singletons; if start is a source of a
+ * transitive orientation, the order is a linear extension of it, and the last vertex is a source
+ * of one whatever start is
+ *
+ * Ross McConnell, Jeremy Spinrad
+ * Ordered vertex partitioning
+ * (2000) Discrete Mathematics and Theoretical Computer Science 4(1)
+ * O(V + E log V)
+ */
+static std::vector<std::size_t> ordered_vertex_partition(const util::csr_graph<std::size_t>& input,
+                                                         std::size_t start) {
+    std::size_t n = input.order();
+    std::vector<std::size_t> element(n), where(n), part(n, 1), first(1, 0), last(1, 1), moved(2, 0);
+    std::iota(element.begin(), element.end(), 0);
+    std::swap(element[0], element[start]);
+    for (std::size_t i = 0; i < n; ++i)
+        where[element[i]] = i;
+    part[start] = 0;
+    first.push_back(1);
+    last.push_back(n);
+
+    std::vector<std::size_t> pivots(1, start), touched;
+    std::vector<bool> queued(n, false);
+    queued[start] = true;
+    auto enqueue = [&pivots, &queued](std::size_t x) {
+        if (!queued[x]) {
+            queued[x] = true;
+            pivots.push_back(x);
+        }
+    };
+    while (!pivots.empty()) {
+        std::size_t y = pivots.back(), own = part[y];
+        pivots.pop_back();
+        queued[y] = false;
+        touched.clear();
+        for (std::size_t j = input.offsets[y]; j < input.offsets[y + 1]; ++j) {
+            std::size_t w = input.targets[j], set = part[w];
+            if (set == own)
+                continue;
+            if (moved[set]++ == 0)
+                touched.push_back(set);
+            std::size_t slot =
+              first[set] < first[own] ? first[set] + moved[set] - 1 : last[set] - moved[set];
+            std::swap(element[where[w]], element[slot]);
+            std::swap(where[w], where[element[where[w]]]);
+        }
+
+        for (std::size_t set : touched) {
+            std::size_t count = moved[set], split = first.size();
+            moved[set] = 0;
+            if (count == last[set] - first[set])
+                continue;
+            if (first[set] < first[own]) {
+                first.push_back(first[set]);
+                last.push_back(first[set] + count);
+                first[set] += count;
+            } else {
+                first.push_back(last[set] - count);
+                last.push_back(last[set]);
+                last[set] -= count;
+            }
+            moved.push_back(0);
+            for (std::size_t i = first[split]; i < last[split]; ++i)
+                part[element[i]] = split;
+
+            std::size_t smaller = split, larger = set;
+            if (last[split] - first[split] > last[set] - first[set])
+                std::swap(smaller, larger);
+            for (std::size_t i = first[smaller]; i < last[smaller]; ++i)
+                enqueue(element[i]);
+            enqueue(element[first[larger]]);
+        }
+    }
+    return element;
+}
+
+/*
+ * Whether orienting every edge from the lower to the higher position is transitive: every
+ * out-neighbor v of u has its out-neighbors among those of u
+ * With bit rows when they take no more words than there are edges: O(kQ/64) for k vertices and Q
+ * edges, otherwise O(QΔ)
+ */
+static bool is_transitive_order(const util::csr_graph<std::size_t>& input,
+                                const std::vector<std::size_t>& position) {
+    const std::size_t NONE = -1;
+    std::size_t n = input.order(), words = (n + 63) / 64;
+    if (n * words <= input.size() + n) {
+        std::vector<std::uint64_t> rows(n * words, 0);
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j)
+                if (position[input.targets[j]] > position[u])
+                    rows[u * words + input.targets[j] / 64] |= std::uint64_t(1)
+                                                               << input.targets[j] % 64;
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j) {
+                std::size_t v = input.targets[j];
+                if (position[v] > position[u])
+                    for (std::size_t i = 0; i < words; ++i)
+                        if (rows[v * words + i] & ~rows[u * words + i])
+                            return false;
+            }
+        return true;
+    }
+
+    std::vector<std::size_t> mark(n, NONE);
+    for (std::size_t u = 0; u < n; ++u) {
+        for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j)
+            mark[input.targets[j]] = u;
+        for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j) {
+            std::size_t v = input.targets[j];
+            if (position[v] < position[u])
+                continue;
+            for (std::size_t l = input.offsets[v]; l < input.offsets[v + 1]; ++l)
+                if (position[input.targets[l]] > position[v] && mark[input.targets[l]] != u &&
+                    input.targets[l] != u)
+                    return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Modules containing a vertex x, given the classes 0 - (k - 1) of the other vertices into
+ * maximal modules not containing x, their quotient (lists sorted) and which classes see x
+ * Class c forces class d when d sees x and c differently: a module holding x and c holds d. The
+ * modules containing x are then x with the classes closed under forcing; they form a chain, so the
+ * strongly connected components of forcing are totally ordered, and each adds one level
+ * component[c] is the level of c, 0 for the outermost; returns the number of levels
+ * Forcing is mostly the complement of the quotient, so the searches step over the unvisited
+ * classes seeing x, skipping those adjacent, in time linear in the quotient
+ *
+ * Andrzej Ehrenfeucht, Harold Gabow, Ross McConnell, Stephen Sullivan
+ * An O(n^2) divide-and-conquer algorithm for the prime tree decomposition of two-structures and
+ * modular decomposition of graphs
+ * (1994) doi:10.1006/jagm.1994.1033
+ * Micha Sharir
+ * A strong-connectivity algorithm and its applications in data flow analysis
+ * (1981) doi:10.1016/0898-1221(81)90008-0
+ * O(k + Q α(k))
+ */
+static std::size_t forcing_levels(const util::csr_graph<std::size_t>& quotient,
+                                  const std::vector<char>& sees_x,
+                                  std::vector<std::size_t>& component) {
+    const std::size_t NONE = -1;
+    std::size_t k = quotient.order();
+
+    // depth-first search along forcing, in finishing order; free[p] leads to the first unvisited
+    // class seeing x at or after position p of near
+    std::vector<std::size_t> near, near_position(k, NONE), finished;
+    for (std::size_t c = 0; c < k; ++c)
+        if (sees_x[c]) {
+            near_position[c] = near.size();
+            near.push_back(c);
+        }
+    std::vector<std::size_t> free(near.size() + 1);
+    std::iota(free.begin(), free.end(), 0);
+    auto next_free = [&free](std::size_t p) {
+        while (free[p] != p) {
+            free[p] = free[free[p]];
+            p = free[p];
+        }
+        return p;
+    };
+    std::vector<char> visited(k, false);
+    auto visit = [&](std::size_t c) {
+        visited[c] = true;
+        if (sees_x[c])
+            free[near_position[c]] = near_position[c] + 1;
+    };
+
+    // edge and adjacency cursors, and the position of the next class seeing x to look at
+    struct frame {
+        std::size_t c, edge, scan, position;
+    };
+    std::vector<frame> frames;
+    for (std::size_t s = 0; s < k; ++s) {
+        if (visited[s])
+            continue;
+        visit(s);
+        frames.push_back({s, quotient.offsets[s], quotient.offsets[s], 0});
+        while (!frames.empty()) {
+            frame& f = frames.back();
+            std::size_t c = f.c, end = quotient.offsets[c + 1], next = NONE;
+            while (next == NONE && f.edge < end) {
+                std::size_t d = quotient.targets[f.edge++];
+                if (!sees_x[d] && !visited[d])
+                    next = d;
+            }
+            for (std::size_t p = next_free(f.position); next == NONE && p < near.size();
+                 p = next_free(f.position)) {
+                std::size_t d = near[p];
+                while (f.scan < end && quotient.targets[f.scan] < d)
+                    ++f.scan;
+                f.position = p + 1;
+                if (f.scan == end || quotient.targets[f.scan] != d)
+                    next = d;
+            }
+
+            if (next == NONE) {
+                finished.push_back(c);
+                frames.pop_back();
+            } else {
+                visit(next);
+                frames.push_back({next, quotient.offsets[next], quotient.offsets[next], 0});
+            }
+        }
+    }
+
+    // searches against forcing in decreasing finishing time; a class seeing x is forced by
+    // exactly the classes not adjacent to it
+    std::size_t levels = 0;
+    std::vector<std::size_t> unvisited(k), kept, stack, mark(k, NONE);
+    std::iota(unvisited.begin(), unvisited.end(), 0);
+    component.assign(k, NONE);
+    for (std::size_t i = finished.size(); i-- > 0;) {
+        if (component[finished[i]] != NONE)
+            continue;
+        component[finished[i]] = levels;
+        stack.assign(1, finished[i]);
+        while (!stack.empty()) {
+            std::size_t d = stack.back();
+            stack.pop_back();
+            if (!sees_x[d]) {
+                for (std::size_t j = quotient.offsets[d]; j < quotient.offsets[d + 1]; ++j)
+                    if (component[quotient.targets[j]] == NONE) {
+                        component[quotient.targets[j]] = levels;
+                        stack.push_back(quotient.targets[j]);
+                    }
+                continue;
+            }
+            for (std::size_t j = quotient.offsets[d]; j < quotient.offsets[d + 1]; ++j)
+                mark[quotient.targets[j]] = d;
+            kept.clear();
+            for (std::size_t c : unvisited) {
+                if (component[c] != NONE)
+                    continue;
+                if (mark[c] == d) {
+                    kept.push_back(c);
+                } else {
+                    component[c] = levels;
+                    stack.push_back(c);
+                }
+            }
+            unvisited.swap(kept);
+        }
+        ++levels;
+    }
+    return levels;
+}
+
+/*
+ * Modular decomposition, and with forward given, a transitive orientation: forward[slot] for
+ * the input slot of every edge in its direction. False if forward is given, verify is set, and
+ * the graph is not a comparability graph
+ *
+ * One partition of the vertices is refined in place. A class that is a module is decomposed by
+ * splitting off its first vertex x and refining the rest until every class is uniform towards
+ * the vertices of the module outside it: the classes are then its maximal modules not containing
+ * x. The modules containing x form the path from x to the module in the tree, found by forcing
+ * on the quotient; the classes hang off that path, and are decomposed in turn
+ * Refinement only moves vertices of the module being decomposed. Every vertex is the first of a
+ * class once, and pivots otherwise only when its class was halved, so no level of the tree is
+ * scanned again
+ *
+ * Every edge joins two children of exactly one node, and is oriented by an order of its children:
+ * any for series nodes, a linear extension of a transitive orientation of the quotient for prime
+ * nodes. The leaves in order of the tree are then a linear extension of the whole orientation
+ *
+ * Tibor Gallai
+ * Transitiv orientierbare Graphen
+ * (1967) doi:10.1007/BF02020961
+ * Ross McConnell, Jeremy Spinrad
+ * Modular decomposition and transitive orientation
+ * (1999) doi:10.1016/S0012-365X(98)00319-7
+ * O(V + E log V), plus checking the orientation of every prime quotient if verify is set
+ */
+template<typename EdgeWeight>
+static bool modular_decomposition_helper(const util::csr_graph<EdgeWeight>& input,
+                                         modular_decomposition_tree& tree,
+                                         std::vector<bool>* forward, bool verify = true) {
+    typedef modular_decomposition_tree::node_type node_type;
+    const std::size_t NONE = -1;
+    std::size_t n = input.order();
+    tree.type.assign(n, node_type::vertex);
+    tree.parent.assign(n, NONE);
+    tree.children.assign(n, std::vector<std::size_t>());
+    tree.root = NONE;
+    if (forward != nullptr)
+        forward->assign(input.size(), false);
+    if (n == 0)
+        return true;
+
+    // rank[node]: place among the children of a prime parent in the order of the orientation
+    std::vector<std::size_t> rank(n, 0);
+    auto attach = [&tree, &rank](std::size_t node, std::size_t parent, std::size_t place) {
+        tree.parent[node] = parent;
+        rank[node] = place;
+        if (parent == NONE)
+            tree.root = node;
+        else
+            tree.children[parent].push_back(node);
+    };
+
+    // owner[set]: the module being decomposed when class set last took part in it
+    partition_refinement<std::size_t> classes(n);
+    std::vector<std::size_t> owner, local;
+    auto own = [&owner, NONE](std::size_t set, std::size_t module) {
+        if (set >= owner.size())
+            owner.resize(set + 1, NONE);
+        owner[set] = module;
+    };
+    auto owned = [&owner](std::size_t set, std::size_t module) {
+        return set < owner.size() && owner[set] == module;
+    };
+
+    // modules still to be decomposed: first vertex, parent node, rank
+    std::vector<std::array<std::size_t, 3>> stack(1, {0, NONE, 0});
+    std::vector<std::size_t> pivots, neighbors, sets, component, level_offsets, by_level;
+    std::vector<bool> queued(n, false);
+    auto enqueue = [&pivots, &queued](std::size_t x) {
+        if (!queued[x]) {
+            queued[x] = true;
+            pivots.push_back(x);
+        }
+    };
+    auto on_split = [&classes, &enqueue](std::size_t larger, std::size_t smaller) {
+        if (classes.class_size(larger) < classes.class_size(smaller))
+            std::swap(larger, smaller);
+        enqueue(classes.first_element(larger));
+        for (std::size_t x = classes.first_element(smaller); x != NONE; x = classes.next_element(x))
+            enqueue(x);
+    };
+    for (std::size_t module = 0; !stack.empty(); ++module) {
+        auto [x, parent, place] = stack.back();
+        stack.pop_back();
+        if (classes.class_size(classes.class_of(x)) == 1) {
+            attach(x, parent, place);
+            continue;
+        }
+
+        own(classes.class_of(x), module);
+        classes.refine(&x, &x + 1);
+        own(classes.class_of(x), module);
+        enqueue(x);
+        while (!pivots.empty()) {
+            std::size_t y = pivots.back(), set = classes.class_of(y);
+            pivots.pop_back();
+            queued[y] = false;
+            neighbors.clear();
+            for (std::size_t j = input.offsets[y]; j < input.offsets[y + 1]; ++j) {
+                std::size_t other = classes.class_of(input.targets[j]);
+                if (other != set && owned(other, module))
+                    neighbors.push_back(input.targets[j]);
+            }
+            classes.refine(neighbors.begin(), neighbors.end(), on_split);
+            for (std::size_t w : neighbors)
+                own(classes.class_of(w), module);
+        }
+
+        // splits stay in place, so the classes of the module follow that of x
+        std::size_t own_class = classes.class_of(x);
+        sets.clear();
+        for (std::size_t set = classes.next_class(own_class); set != NONE && owned(set, module);
+             set = classes.next_class(set)) {
+            if (set >= local.size())
+                local.resize(set + 1);
+            local[set] = sets.size();
+            sets.push_back(set);
+        }
+        std::size_t k = sets.size();
+        std::vector<char> sees_x(k, false);
+        for (std::size_t j = input.offsets[x]; j < input.offsets[x + 1]; ++j) {
+            std::size_t set = classes.class_of(input.targets[j]);
+            if (set != own_class && owned(set, module))
+                sees_x[local[set]] = true;
+        }
+
+        // quotient: classes are modules, so their first vertices see every adjacent class
+        util::csr_graph<std::size_t> quotient;
+        quotient.offsets.push_back(0);
+        std::vector<std::size_t> mark(k, NONE);
+        for (std::size_t c = 0; c < k; ++c) {
+            std::size_t r = classes.first_element(sets[c]);
+            for (std::size_t j = input.offsets[r]; j < input.offsets[r + 1]; ++j) {
+                std::size_t set = classes.class_of(input.targets[j]);
+                if (set == own_class || set == sets[c] || !owned(set, module))
+                    continue;
+                std::size_t d = local[set];
+                if (mark[d] != c) {
+                    mark[d] = c;
+                    quotient.targets.push_back(d);
+                }
+            }
+            quotient.offsets.push_back(quotient.targets.size());
+        }
+        quotient.weights.assign(quotient.size(), 0);
+        quotient = util::transpose(quotient); // sorted lists
+
+        // classes by level, outermost first
+        std::size_t levels = forcing_levels(quotient, sees_x, component);
+        level_offsets.assign(levels + 1, 0);
+        for (std::size_t c = 0; c < k; ++c)
+            ++level_offsets[component[c] + 1];
+        for (std::size_t l = 0; l < levels; ++l)
+            level_offsets[l + 1] += level_offsets[l];
+        by_level.resize(k);
+        std::vector<std::size_t> slot(level_offsets.begin(), level_offsets.end() - 1);
+        for (std::size_t c = 0; c < k; ++c)
+            by_level[slot[component[c]]++] = c;
+
+        // a level of one class adds a degenerate node, which absorbs a root of its own type
+        // below it; the classes of a level of several are the children of a prime node
+        std::vector<std::size_t> position;
+        for (std::size_t l = 0; l < levels; ++l) {
+            std::size_t begin = level_offsets[l], end = level_offsets[l + 1];
+            node_type type = end - begin > 1         ? node_type::prime
+                             : sees_x[by_level[begin]] ? node_type::series
+                                                       : node_type::parallel;
+            std::size_t node = parent;
+            if (l > 0 || parent == NONE || type == node_type::prime || tree.type[parent] != type) {
+                node = tree.size();
+                tree.type.push_back(type);
+                tree.parent.push_back(NONE);
+                tree.children.emplace_back();
+                rank.push_back(0);
+                attach(node, parent, place);
+            }
+
+            // quotient of a prime node: 0 for the child holding x, then the classes of the level
+            position.assign(end - begin + 1, 0);
+            if (forward != nullptr && type == node_type::prime) {
+                util::csr_graph<std::size_t> prime;
+                prime.offsets.push_back(0);
+                for (std::size_t i = begin; i < end; ++i) {
+                    local[sets[by_level[i]]] = i - begin + 1;
+                    if (sees_x[by_level[i]])
+                        prime.targets.push_back(i - begin + 1);
+                }
+                prime.offsets.push_back(prime.targets.size());
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t c = by_level[i];
+                    if (sees_x[c])
+                        prime.targets.push_back(0);
+                    for (std::size_t j = quotient.offsets[c]; j < quotient.offsets[c + 1]; ++j)
+                        if (component[quotient.targets[j]] == l)
+                            prime.targets.push_back(local[sets[quotient.targets[j]]]);
+                    prime.offsets.push_back(prime.targets.size());
+                }
+                std::vector<std::size_t> order =
+                  ordered_vertex_partition(prime, ordered_vertex_partition(prime, 0).back());
+                for (std::size_t i = 0; i < order.size(); ++i)
+                    position[order[i]] = i;
+                if (verify && !is_transitive_order(prime, position))
+                    return false;
+            }
+
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t first = classes.first_element(sets[by_level[i]]);
+                if (classes.class_size(sets[by_level[i]]) == 1)
+                    attach(first, node, position[i - begin + 1]);
+                else
+                    stack.push_back({first, node, position[i - begin + 1]});
+            }
+            parent = node;
+            place = position[0];
+        }
+        attach(x, parent, place);
+    }
+
+    if (forward != nullptr) {
+        // children of prime nodes in order; leaves in order of the tree
+        std::vector<std::size_t> ordered, leaf_position(n), search(1, tree.root);
+        for (std::size_t node = n; node < tree.size(); ++node)
+            if (tree.type[node] == node_type::prime) {
+                ordered.resize(tree.children[node].size());
+                for (std::size_t child : tree.children[node])
+                    ordered[rank[child]] = child;
+                tree.children[node].swap(ordered);
+            }
+        for (std::size_t count = 0; !search.empty();) {
+            std::size_t node = search.back();
+            search.pop_back();
+            if (node < n)
+                leaf_position[node] = count++;
+            search.insert(search.end(), tree.children[node].rbegin(), tree.children[node].rend());
+        }
+        for (std::size_t v = 0; v < n; ++v)
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                (*forward)[j] = leaf_position[v] < leaf_position[input.targets[j]];
+    }
+    return true;
+}
+
+/*
+ * Modular decomposition tree of an undirected graph
+ * O(V + E log V)
+ */
+template<typename EdgeWeight>
+modular_decomposition_tree modular_decomposition(const util::csr_graph<EdgeWeight>& input) {
+    modular_decomposition_tree result;
+    modular_decomposition_helper(input, result, nullptr);
+    return result;
+}
+
+// Vertices numbered as in src.get_translation()
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+modular_decomposition_tree
+  modular_decomposition(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
+    return modular_decomposition(util::get_csr_rep(src));
+}
+
+/*
+ * Whether the edges of an undirected graph can be oriented transitively: u -> v -> w implies
+ * u -> w. These are the graphs of the comparabilities of partial orders
+ * O(V + E log V), plus O(kQ/64) or O(QΔ) for checking every prime quotient of k vertices, Q edges
+ * and maximum degree Δ
+ */
+template<typename EdgeWeight>
+bool is_comparability_graph(const util::csr_graph<EdgeWeight>& input) {
+    modular_decomposition_tree tree;
+    std::vector<bool> forward;
+    return modular_decomposition_helper(input, tree, &forward);
+}
+
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+bool is_comparability_graph(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src) {
+    return is_comparability_graph(util::get_csr_rep(src));
+}
+
+/*
+ * Transitive orientation of a comparability graph: every edge once, in its direction, with its
+ * weight. The result is acyclic
+ * Throws std::domain_error if the graph is not a comparability graph
+ * O(V + E log V), plus checking every prime quotient as above
+ */
+template<typename EdgeWeight>
+util::csr_graph<EdgeWeight> transitive_orientation(const util::csr_graph<EdgeWeight>& input) {
+    modular_decomposition_tree tree;
+    std::vector<bool> forward;
+    if (!modular_decomposition_helper(input, tree, &forward))
+        throw std::domain_error("Not a comparability graph");
+
+    util::csr_graph<EdgeWeight> result;
+    result.offsets.push_back(0);
+    for (std::size_t v = 0; v < input.order(); ++v) {
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            if (forward[j]) {
+                result.targets.push_back(input.targets[j]);
+                result.weights.push_back(input.weights[j]);
+            }
+        result.offsets.push_back(result.targets.size());
+    }
+    return result;
+}
 
-// WIP
 template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
 graph::graph<Vertex, true, Weighted, EdgeWeight, Args...>
   transitive_orientation(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& input) {
+    util::csr_graph<EdgeWeight> oriented = transitive_orientation(util::get_csr_rep(input));
+    std::vector<Vertex> vertices = input.vertices();
     graph::graph<Vertex, true, Weighted, EdgeWeight, Args...> result;
-    for (const Vertex& v : input.vertices())
+    for (const Vertex& v : vertices)
         result.add_vertex(v);
-    if (result.order() == 0)
-        return result;
-
-    std::vector<std::list<Vertex>> sets;
-    std::unordered_map<Vertex, std::size_t, Args...> get_set;
-    std::list<std::size_t> empty_sets;
-    std::unordered_map<Vertex, std::pair<std::list<Vertex>, bool>, Args...> unsplit_oriented;
-
-    Vertex start = generate_lex_bfs(input).back();
-    for (const std::pair<Vertex, EdgeWeight>& e : input.edges(start)) {
-        result.force_add(start, e.first, e.second);
-        unsplit_oriented[start].first.push_back(e.first);
-    }
-    unsplit_oriented[start].second =
-      true; // determines orientation of edges: true means pointing to these vertices
-
-    sets.resize(2);
-    sets[0].push_back(start);
-    get_set[start] = 0;
-    for (const Vertex& v : input.vertices())
-        if (v != start) {
-            sets[1].push_back(v);
-            get_set[v] = 1;
-        }
-
-    std::vector<std::pair<std::size_t, std::size_t>> split_tracker(input.order() + 1,
-                                                                   std::make_pair(0U, 0U));
-    std::size_t current_step = 0;
-    while (!unsplit_oriented.empty()) {
-        ++current_step;
-        auto next_it = unsplit_oriented.begin();
-    }
+    for (std::size_t v = 0; v < oriented.order(); ++v)
+        for (std::size_t j = oriented.offsets[v]; j < oriented.offsets[v + 1]; ++j)
+            result.force_add(vertices[v], vertices[oriented.targets[j]], oriented.weights[j]);
+    return result;
 }
 } // namespace graph_alg
 
@@ -0,0 +1,259 @@
+#ifndef GRAPH_PAGERANK_H
+#define GRAPH_PAGERANK_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+namespace graph_alg {
+/*
+ * PageRank of a directed graph in CSR form (undirected graphs with both directions of every edge
+ * stored): the stationary distribution of a walk that follows a uniformly chosen out-edge with
+ * probability damping, and otherwise jumps to a seed. Parallel edges count with their
+ * multiplicity, weights are ignored; vertices without out-edges jump to a seed
+ * Seeds are chosen uniformly from the given list, or from all vertices if it is empty
+ * (personalized PageRank otherwise); duplicates weigh more
+ *
+ * Lawrence Page, Sergey Brin, Rajeev Motwani, Terry Winograd
+ * The PageRank citation ranking: bringing order to the web
+ * (1999) Stanford InfoLab 1999-66
+ */
+struct pagerank_result {
+    std::vector<double> rank;
+
+    // L1 norm of the change made by every sweep (pull, Gauss-Seidel), or the mass left to push
+    // after every round (push). The L1 error of power iteration is at most damping / (1 - damping)
+    // times its last change, that of push at most the mass left
+    std::vector<double> residuals;
+    std::size_t edges_scanned = 0;
+    bool converged = false;
+
+    std::size_t iterations() const noexcept { return residuals.size(); }
+};
+
+// Jump distribution over n vertices
+static std::vector<double> pagerank_teleport(std::size_t n, const std::vector<std::size_t>& seeds) {
+    if (seeds.empty())
+        return std::vector<double>(n, 1.0 / static_cast<double>(n));
+    std::vector<double> result(n, 0);
+    for (std::size_t s : seeds) {
+        if (s >= n)
+            throw std::invalid_argument("Seeds must be vertices");
+        result[s] += 1.0 / static_cast<double>(seeds.size());
+    }
+    return result;
+}
+
+static void pagerank_check(double damping, double tolerance) {
+    if (!(damping >= 0 && damping < 1))
+        throw std::invalid_argument("Damping must lie in [0, 1)");
+    if (!(tolerance > 0))
+        throw std::invalid_argument("Tolerance must be positive");
+}
+
+/*
+ * Power iteration, pulling over in-edges: every vertex sums the shares of its in-neighbors, so
+ * vertices are updated concurrently without synchronization, on num_threads threads (0: all
+ * hardware threads). Stops once a sweep changes the ranks by less than tolerance in L1 norm
+ * Θ(V+E) per sweep, converging linearly at rate damping
+ */
+template<typename EdgeWeight>
+pagerank_result pagerank(const util::csr_graph<EdgeWeight>& input,
+                         const std::vector<std::size_t>& seeds = {}, double damping = 0.85,
+                         double tolerance = 1e-9, unsigned num_threads = 1,
+                         std::size_t max_iterations = 1000) {
+    pagerank_check(damping, tolerance);
+    std::size_t n = input.order();
+    unsigned threads = util::thread_count(num_threads);
+    util::csr_graph<EdgeWeight> reverse = util::transpose(input);
+    std::vector<double> teleport = pagerank_teleport(n, seeds);
+
+    pagerank_result result;
+    result.rank = teleport;
+    result.converged = n == 0;
+    std::vector<double> next(n), share(n), partial_dangling(threads), partial_change(threads);
+    while (!result.converged && result.iterations() < max_iterations) {
+        std::fill(partial_dangling.begin(), partial_dangling.end(), 0);
+        std::fill(partial_change.begin(), partial_change.end(), 0);
+        util::parallel_blocks(0, n, threads, [&](unsigned id, std::size_t first, std::size_t last) {
+            for (std::size_t u = first; u < last; ++u) {
+                if (input.degree(u) == 0)
+                    partial_dangling[id] += result.rank[u];
+                share[u] = input.degree(u) == 0 ? 0 : result.rank[u] / input.degree(u);
+            }
+        });
+        double dangling = 0;
+        for (double mass : partial_dangling)
+            dangling += mass;
+
+        util::parallel_blocks(0, n, threads, [&](unsigned id, std::size_t first, std::size_t last) {
+            for (std::size_t v = first; v < last; ++v) {
+                double sum = 0;
+                for (std::size_t j = reverse.offsets[v]; j < reverse.offsets[v + 1]; ++j)
+                    sum += share[reverse.targets[j]];
+                next[v] = damping * (sum + dangling * teleport[v]) + (1 - damping) * teleport[v];
+                partial_change[id] += std::abs(next[v] - result.rank[v]);
+            }
+        });
+        result.rank.swap(next);
+        result.edges_scanned += input.size();
+
+        double change = 0;
+        for (double part : partial_change)
+            change += part;
+        result.residuals.push_back(change);
+        result.converged = change < tolerance;
+    }
+    return result;
+}
+
+/*
+ * Gauss-Seidel iteration: ranks are updated in place in vertex order, so every sweep already uses
+ * the new ranks of the vertices before it; sequential, and usually needs about half the sweeps of
+ * power iteration. Ranks are rescaled to sum 1 after every sweep, as an error in the total would
+ * otherwise only decay at rate damping
+ * Stops once a sweep changes the ranks by less than tolerance in L1 norm
+ * Θ(V+E) per sweep
+ */
+template<typename EdgeWeight>
+pagerank_result pagerank_Gauss_Seidel(const util::csr_graph<EdgeWeight>& input,
+                                      const std::vector<std::size_t>& seeds = {},
+                                      double damping = 0.85, double tolerance = 1e-9,
+                                      std::size_t max_iterations = 1000) {
+    pagerank_check(damping, tolerance);
+    std::size_t n = input.order();
+    util::csr_graph<EdgeWeight> reverse = util::transpose(input);
+    std::vector<double> teleport = pagerank_teleport(n, seeds);
+
+    pagerank_result result;
+    result.rank = teleport;
+    result.converged = n == 0;
+    double dangling = 0;
+    for (std::size_t u = 0; u < n; ++u)
+        if (input.degree(u) == 0)
+            dangling += result.rank[u];
+    while (!result.converged && result.iterations() < max_iterations) {
+        double change = 0;
+        for (std::size_t v = 0; v < n; ++v) {
+            double sum = 0;
+            for (std::size_t j = reverse.offsets[v]; j < reverse.offsets[v + 1]; ++j)
+                sum += result.rank[reverse.targets[j]] / input.degree(reverse.targets[j]);
+            double value = damping * (sum + dangling * teleport[v]) + (1 - damping) * teleport[v];
+            if (input.degree(v) == 0)
+                dangling += value - result.rank[v];
+            change += std::abs(value - result.rank[v]);
+            result.rank[v] = value;
+        }
+        double total = 0;
+        for (double value : result.rank)
+            total += value;
+        for (double& value : result.rank)
+            value /= total;
+        dangling /= total;
+        result.edges_scanned += input.size();
+        result.residuals.push_back(change);
+        result.converged = change < tolerance;
+    }
+    return result;
+}
+
+/*
+ * Personalized PageRank by forward push: every seed starts with its share of residual mass, and a
+ * vertex holding residual r keeps (1 - damping) r as rank and passes damping r on, evenly to its
+ * out-neighbors (or to the seeds, if it has none). Vertices are pushed in rounds, first in first
+ * out, while their residual is at least tolerance times their out-degree (tolerance without
+ * out-edges); the residual mass left bounds the L1 error, and is at most tolerance * (V + E)
+ * Only the neighborhood the mass reaches is scanned: O(1 / ((1 - damping) tolerance)) work,
+ * independent of the size of the graph, besides the O(V) result
+ *
+ * Reid Andersen, Fan Chung, Kevin Lang
+ * Local graph partitioning using PageRank vectors
+ * (2006) doi:10.1109/FOCS.2006.44
+ */
+template<typename EdgeWeight>
+pagerank_result personalized_pagerank(const util::csr_graph<EdgeWeight>& input,
+                                      const std::vector<std::size_t>& seeds, double damping = 0.85,
+                                      double tolerance = 1e-9) {
+    pagerank_check(damping, tolerance);
+    if (seeds.empty())
+        throw std::invalid_argument("Personalized PageRank needs a seed");
+    std::size_t n = input.order();
+    std::vector<double> teleport = pagerank_teleport(n, seeds);
+    auto threshold = [&input, tolerance](std::size_t u) {
+        return tolerance * static_cast<double>(std::max<std::size_t>(input.degree(u), 1));
+    };
+
+    pagerank_result result;
+    result.rank.assign(n, 0);
+    std::vector<double> residual(teleport);
+    std::vector<char> queued(n, false);
+    std::vector<std::size_t> round, next_round;
+    for (std::size_t s = 0; s < n; ++s)
+        if (residual[s] >= threshold(s)) {
+            queued[s] = true;
+            round.push_back(s);
+        }
+    std::vector<std::size_t> targets; // seeds, for vertices without out-edges
+    for (std::size_t s = 0; s < n; ++s)
+        if (teleport[s] > 0)
+            targets.push_back(s);
+
+    double left = 1;
+    auto add = [&](std::size_t w, double mass) {
+        residual[w] += mass;
+        if (!queued[w] && residual[w] >= threshold(w)) {
+            queued[w] = true;
+            next_round.push_back(w);
+        }
+    };
+    while (!round.empty()) {
+        for (std::size_t u : round) {
+            double mass = residual[u];
+            residual[u] = 0;
+            queued[u] = false;
+            result.rank[u] += (1 - damping) * mass;
+            left -= (1 - damping) * mass;
+            if (input.degree(u) == 0) {
+                for (std::size_t s : targets)
+                    add(s, damping * mass * teleport[s]);
+            } else {
+                double share = damping * mass / input.degree(u);
+                for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j)
+                    add(input.targets[j], share);
+                result.edges_scanned += input.degree(u);
+            }
+        }
+        round.swap(next_round);
+        next_round.clear();
+        result.residuals.push_back(std::max(left, 0.0));
+    }
+    result.converged = true;
+    return result;
+}
+
+// Vertex names, numbered as in src.get_translation(); seeds as above
+template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
+std::unordered_map<Vertex, double, Args...>
+  pagerank(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& src,
+           const std::vector<Vertex>& seeds = {}, double damping = 0.85, double tolerance = 1e-9,
+           unsigned num_threads = 1) {
+    std::vector<std::size_t> ids;
+    for (const Vertex& s : seeds)
+        ids.push_back(src.get_translation().at(s));
+    pagerank_result ranks = pagerank(util::get_csr_rep(src), ids, damping, tolerance, num_threads);
+    std::vector<Vertex> vertices = src.vertices();
+    std::unordered_map<Vertex, double, Args...> result;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        result.emplace(vertices[v], ranks.rank[v]);
+    return result;
+}
+} // namespace graph_alg
+
+#endif // GRAPH_PAGERANK_H
@@ -0,0 +1,157 @@
+#ifndef GRAPH_REACHABILITY_H
+#define GRAPH_REACHABILITY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+#include "components.h"
+#include "search.h"
+
+namespace graph_alg {
+/*
+ * Reachability queries on a directed graph on dense ids, without storing its closure
+ *
+ * Strongly connected components are condensed; every component of the DAG then gets num_labels
+ * intervals [low, post] from randomized depth-first traversals, where post is the postorder rank
+ * and low the smallest rank below it. If v is reachable from u, every interval of v is nested in
+ * the matching interval of u, so most negative queries stop at the labels; the rest fall back to
+ * a depth-first search that only enters components whose intervals still contain v's
+ *
+ * Hilmi Yildirim, Vineet Chaoji, Mohammed J. Zaki
+ * GRAIL: scalable reachability index for large graphs
+ * (2010) doi:10.14778/1920841.1920879
+ *
+ * Construction: O(d(V+E)) for d labels, on up to d threads
+ * Memory: O(V + E + dV)
+ * Query: O(d) when the labels decide, O(V+E) worst case
+ */
+class reachability_index {
+    public:
+    // Scratch space of the fallback search; one per thread querying the same index
+    struct query_state {
+        std::vector<std::uint32_t> visited; // stamp of the last query that entered a component
+        std::vector<std::size_t> stack;
+        std::uint32_t stamp = 0;
+    };
+
+    template<typename EdgeWeight>
+    explicit reachability_index(const util::csr_graph<EdgeWeight>& input, unsigned num_labels = 3,
+                                unsigned num_threads = 1) :
+        _scc(strongly_connected_condensation(input)),
+        _num_labels(std::max(num_labels, 1U)),
+        _low(size() * _num_labels),
+        _post(size() * _num_labels),
+        _state() {
+        util::parallel_for(0, _num_labels, num_threads,
+                           [this](unsigned, std::size_t label) { _build_label(label); });
+    }
+
+    // Whether vertex v can be reached from vertex u, searching with the index's own scratch space
+    bool reaches(std::size_t u, std::size_t v) { return reaches(u, v, _state); }
+
+    // Whether vertex v can be reached from vertex u, searching with the caller's scratch space
+    // Safe to call concurrently on the same index as long as every thread has its own state
+    bool reaches(std::size_t u, std::size_t v, query_state& state) const {
+        std::size_t source = _scc.component[u], target = _scc.component[v];
+        if (source == target)
+            return true;
+        if (!_may_reach(source, target))
+            return false;
+
+        // stamps mark the components seen by this query only
+        if (state.visited.size() != size() || ++state.stamp == 0) {
+            state.visited.assign(size(), 0);
+            state.stamp = 1;
+        }
+        const util::csr_graph<std::size_t>& dag = _scc.dag;
+        std::vector<std::size_t>& stack = state.stack;
+        stack.assign(1, source);
+        state.visited[source] = state.stamp;
+        while (!stack.empty()) {
+            std::size_t c = stack.back();
+            stack.pop_back();
+            for (std::size_t j = dag.offsets[c]; j < dag.offsets[c + 1]; ++j) {
+                std::size_t d = dag.targets[j];
+                if (d == target)
+                    return true;
+                if (state.visited[d] != state.stamp && _may_reach(d, target)) {
+                    state.visited[d] = state.stamp;
+                    stack.push_back(d);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Number of strongly connected components
+    std::size_t size() const noexcept { return _scc.size(); }
+
+    const condensation& components() const noexcept { return _scc; }
+
+    private:
+    // Necessary condition for component d to be reachable from c:
+    // ids are in reverse topological order, and the intervals of d nest in those of c
+    bool _may_reach(std::size_t c, std::size_t d) const noexcept {
+        if (d > c)
+            return false;
+        for (std::size_t i = 0; i < _num_labels; ++i) {
+            std::size_t x = c * _num_labels + i, y = d * _num_labels + i;
+            if (_low[y] < _low[x] || _post[x] < _post[y])
+                return false;
+        }
+        return true;
+    }
+
+    // One randomized traversal: shuffled roots and shuffled edge order
+    void _build_label(std::size_t label) {
+        std::size_t k = size();
+        std::mt19937_64 engine(label);
+        util::csr_graph<std::size_t> dag = _scc.dag;
+        for (std::size_t c = 0; c < k; ++c)
+            std::shuffle(dag.targets.begin() + dag.offsets[c],
+                         dag.targets.begin() + dag.offsets[c + 1], engine);
+        std::vector<std::size_t> roots(k);
+        std::iota(roots.begin(), roots.end(), 0);
+        std::shuffle(roots.begin(), roots.end(), engine);
+
+        std::vector<std::size_t> low(k), post(k);
+        std::size_t rank = 0;
+        depth_first_state state(k);
+        for (std::size_t root : roots) {
+            if (state.visited(root))
+                continue;
+            depth_first_visit(
+              dag, root, state, [&low](std::size_t c) { low[c] = static_cast<std::size_t>(-1); },
+              [&](std::size_t c, std::size_t d, dfs_edge kind) {
+                  // a finished successor has its final low value
+                  if (kind != dfs_edge::tree)
+                      low[c] = std::min(low[c], low[d]);
+              },
+              [&](std::size_t parent, std::size_t c) {
+                  post[c] = rank++;
+                  low[c] = std::min(low[c], post[c]);
+                  if (parent != depth_first_state::NONE)
+                      low[parent] = std::min(low[parent], low[c]);
+              });
+        }
+
+        for (std::size_t c = 0; c < k; ++c) {
+            _low[c * _num_labels + label] = low[c];
+            _post[c * _num_labels + label] = post[c];
+        }
+    }
+
+    condensation _scc;
+    std::size_t _num_labels;
+    std::vector<std::size_t> _low, _post; // num_labels consecutive entries per component
+    query_state _state;
+};
+} // namespace graph_alg
+
+#endif // GRAPH_REACHABILITY_H
@@ -1,61 +1,164 @@
 #ifndef GRAPH_SEARCH_H
 #define GRAPH_SEARCH_H
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <list>
+#include <numeric>
 #include <queue>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <structures/graph.h>
-#include <structures/partitioner.h>
+#include <structures/partition_refinement.h>
 
-// Recursive helpers for DFS
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+// Helper for tree-style DFS: vertices are revisited on every path, so there is no visited state
+// Explicit stack of neighbor lists instead of recursion
 template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename Hash,
          typename KeyEqual, typename F1, typename F2>
-static bool depth_first_helper(
+static bool depth_first_tree_helper(
   const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Hash, KeyEqual>& src,
-  const Vertex& current, F1& on_visit, F2& on_backtrack,
-  std::unordered_map<Vertex, bool, Hash, KeyEqual>& visited) {
-    visited[current] = true;
-
-    // account for if the user specified when to terminate early
-    if constexpr (std::is_convertible_v<std::result_of_t<F1(Vertex)>, bool>) {
-        if (on_visit(current))
-            return true;
-    } else {
-        on_visit(current);
-    }
-
-    for (const Vertex& neighbor : src.neighbors(current)) {
-        if (!visited[neighbor]) {
-            if (depth_first_helper(src, neighbor, on_visit, on_backtrack, visited))
+  const Vertex& start, F1& on_visit, F2& on_backtrack) {
+    struct frame {
+        Vertex vertex;
+        std::list<Vertex> neighbors;
+        typename std::list<Vertex>::const_iterator next;
+    };
+    auto visit = [&src, &on_visit](std::deque<frame>& stack, const Vertex& v) {
+        if constexpr (std::is_convertible_v<std::result_of_t<F1(Vertex)>, bool>) {
+            if (on_visit(v))
                 return true;
-            on_backtrack(current, neighbor);
+        } else {
+            on_visit(v);
         }
+        stack.push_back(frame{v, src.neighbors(v), {}});
+        stack.back().next = stack.back().neighbors.cbegin();
+        return false;
+    };
+
+    std::deque<frame> stack;
+    if (visit(stack, start))
+        return true;
+    while (!stack.empty()) {
+        frame& top = stack.back();
+        if (top.next == top.neighbors.cend()) {
+            Vertex child = std::move(top.vertex);
+            stack.pop_back();
+            if (!stack.empty())
+                on_backtrack(stack.back().vertex, child);
+            continue;
+        }
+        if (visit(stack, *(top.next++)))
+            return true;
     }
     return false;
 }
 
-template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename Hash,
-         typename KeyEqual, typename F1, typename F2>
-static bool depth_first_tree_helper(
-  const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Hash, KeyEqual>& src,
-  const Vertex& current, F1& on_visit, F2& on_backtrack) {
-    if constexpr (std::is_convertible_v<std::result_of_t<F1(Vertex)>, bool>) {
-        if (on_visit(current))
-            return true;
-    } else {
-        on_visit(current);
+namespace graph_alg {
+// Classification of an edge u -> v met during a depth-first search
+enum class dfs_edge {
+    tree,    // v was undiscovered, and is visited from u
+    back,    // v is an ancestor of u (still open)
+    forward, // v is a finished descendant of u
+    cross    // v is finished and not a descendant of u
+};
+
+/*
+Scratch space for depth_first_visit on vertices 0 - (n - 1)
+Discovery and finish times persist across calls, so a forest is searched one root at a time
+*/
+struct depth_first_state {
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    std::vector<std::size_t> discovered; // discovery time, NONE if unvisited
+    std::vector<std::size_t> finished;   // finish time, NONE while open or unvisited
+    std::vector<std::size_t> next_edge;  // position in the edge list of each open vertex
+    std::vector<std::size_t> stack;      // open vertices, root first
+    std::size_t time = 0;
+
+    explicit depth_first_state(std::size_t n = 0) :
+        discovered(n, NONE), finished(n, NONE), next_edge(n) {}
+
+    bool visited(std::size_t v) const noexcept { return discovered[v] != NONE; }
+
+    // Mark v unvisited again, to search a subset of vertices with a previously used state
+    void reset(std::size_t v) noexcept { discovered[v] = finished[v] = NONE; }
+};
+
+/*
+Iterative depth-first search on a CSR graph from root, over the vertices not yet visited in state
+1. on_discover(v) on arrival; if it returns a bool value of true, the whole search stops
+2. on_edge(u, v, kind) for every edge out of u, in order; if it returns a bool value of false on a
+   tree edge, the edge is skipped and v stays unvisited
+3. on_finish(parent, v) once every edge out of v is done (parent is depth_first_state::NONE for
+   root)
+Returns true if stopped early
+
+Runs on an explicit stack: O(V) heap memory, no recursion
+Θ(V+E)
+*/
+template<typename EdgeWeight, typename FD, typename FE, typename FF>
+bool depth_first_visit(const util::csr_graph<EdgeWeight>& input, std::size_t root,
+                       depth_first_state& state, FD on_discover, FE on_edge, FF on_finish) {
+    static_assert(std::is_invocable_v<FD, std::size_t> &&
+                    std::is_invocable_v<FE, std::size_t, std::size_t, dfs_edge> &&
+                    std::is_invocable_v<FF, std::size_t, std::size_t>,
+                  "incompatible functions");
+    auto discover = [&](std::size_t v) {
+        state.discovered[v] = state.time++;
+        state.next_edge[v] = input.offsets[v];
+        state.stack.push_back(v);
+        if constexpr (std::is_convertible_v<std::invoke_result_t<FD&, std::size_t>, bool>) {
+            return static_cast<bool>(on_discover(v));
+        } else {
+            on_discover(v);
+            return false;
+        }
+    };
+
+    state.stack.clear();
+    if (discover(root)) {
+        state.stack.clear();
+        return true;
     }
-    for (const Vertex& neighbor : src.neighbors(current)) {
-        if (depth_first_tree_helper(src, neighbor, on_visit, on_backtrack))
-            return true;
-        on_backtrack(current, neighbor);
+    while (!state.stack.empty()) {
+        std::size_t u = state.stack.back();
+        if (state.next_edge[u] != input.offsets[u + 1]) {
+            std::size_t v = input.targets[state.next_edge[u]++];
+            dfs_edge kind = dfs_edge::cross;
+            if (!state.visited(v))
+                kind = dfs_edge::tree;
+            else if (state.finished[v] == depth_first_state::NONE)
+                kind = dfs_edge::back;
+            else if (state.discovered[u] < state.discovered[v])
+                kind = dfs_edge::forward;
+            bool follow = true;
+            if constexpr (std::is_convertible_v<
+                            std::invoke_result_t<FE&, std::size_t, std::size_t, dfs_edge>, bool>)
+                follow = on_edge(u, v, kind);
+            else
+                on_edge(u, v, kind);
+
+            if (kind == dfs_edge::tree && follow && discover(v)) {
+                state.stack.clear();
+                return true;
+            }
+            continue;
+        }
+
+        state.stack.pop_back();
+        state.finished[u] = state.time++;
+        on_finish(state.stack.empty() ? depth_first_state::NONE : state.stack.back(), u);
     }
     return false;
 }
 
-namespace graph_alg {
 /*
 Depth-first search on src starting with startVertex
 On each vertex:
@@ -76,18 +179,23 @@ void depth_first(
   F2 on_backtrack = [](const Vertex& parent, const Vertex& child) {}) {
     static_assert(std::is_invocable_v<F1, Vertex> && std::is_invocable_v<F2, Vertex, Vertex>,
                   "incompatible functions");
-    std::unordered_map<Vertex, bool, Args...> visited;
     std::vector<Vertex> vertices = src.vertices();
     if (vertices.empty())
         return;
 
-    for (const Vertex& vertex : vertices)
-        visited[vertex] = false;
-
-    if (visited.find(start) == visited.end())
+    auto start_it = src.get_translation().find(start);
+    if (start_it == src.get_translation().end())
         throw std::out_of_range("Vertex does not exist");
 
-    depth_first_helper(src, start, on_arrival, on_backtrack, visited);
+    depth_first_state state(vertices.size());
+    depth_first_visit(
+      util::get_csr_rep(src), start_it->second, state,
+      [&](std::size_t v) { return on_arrival(vertices[v]); },
+      [](std::size_t, std::size_t, dfs_edge) {},
+      [&](std::size_t parent, std::size_t child) {
+          if (parent != depth_first_state::NONE)
+              on_backtrack(vertices[parent], vertices[child]);
+      });
 }
 
 /*
@@ -105,32 +213,33 @@ void depth_first_forest(
     static_assert(std::is_invocable_v<F1, Vertex> && std::is_invocable_v<F2, Vertex, Vertex> &&
                     std::is_invocable_v<F3, Vertex>,
                   "incompatible functions");
-    std::unordered_map<Vertex, bool, Args...> visited;
     std::vector<Vertex> vertices = src.vertices();
     if (vertices.empty())
         return;
 
-    for (const Vertex& vertex : vertices)
-        visited[vertex] = false;
-
-    if (visited.find(start) == visited.end())
+    auto start_it = src.get_translation().find(start);
+    if (start_it == src.get_translation().end())
         throw std::out_of_range("Vertex does not exist");
 
-    if (depth_first_helper(src, start, on_arrival, on_backtrack, visited))
-        return;
-
-    on_finish_root(start);
-
-    auto findUnvisited = [](const std::pair<Vertex, bool>& x) {
-        return !x.second;
+    util::csr_graph<EdgeWeight> csr = util::get_csr_rep(src);
+    depth_first_state state(vertices.size());
+    auto search = [&](std::size_t root) {
+        return depth_first_visit(
+          csr, root, state, [&](std::size_t v) { return on_arrival(vertices[v]); },
+          [](std::size_t, std::size_t, dfs_edge) {},
+          [&](std::size_t parent, std::size_t child) {
+              if (parent != depth_first_state::NONE)
+                  on_backtrack(vertices[parent], vertices[child]);
+              else
+                  on_finish_root(vertices[child]);
+          });
     };
 
-    for (auto it = std::find_if(visited.cbegin(), visited.cend(), findUnvisited);
-         it != visited.cend(); it = std::find_if(visited.cbegin(), visited.cend(), findUnvisited)) {
-        if (depth_first_helper(src, it->first, on_arrival, on_backtrack, visited))
+    if (search(start_it->second))
+        return;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        if (!state.visited(v) && search(v))
             return;
-        on_finish_root(it->first);
-    }
 }
 
 /*
@@ -205,33 +314,130 @@ void breadth_first(
     }
 }
 
+// Lexicographic search on dense ids: repeatedly take the first vertex of the first class, then
+// refine the classes by its out-neighbors
+// Neighbor lists are first bucketed into initial_order, which keeps every class in that order
+template<typename EdgeWeight>
+static std::vector<std::size_t>
+  lexicographic_search(const util::csr_graph<EdgeWeight>& input,
+                       const std::vector<std::size_t>& initial_order,
+                       typename partition_refinement<std::size_t>::placement where) {
+    std::size_t n = input.order();
+    if (initial_order.size() != n)
+        throw std::invalid_argument("Initial order must hold every vertex");
+    util::csr_graph<EdgeWeight> reverse = util::transpose(input);
+    std::vector<std::size_t> position(input.offsets.begin(), input.offsets.end() - 1);
+    std::vector<std::size_t> sorted_targets(input.size());
+    for (std::size_t v : initial_order)
+        for (std::size_t j = reverse.offsets[v]; j < reverse.offsets[v + 1]; ++j)
+            sorted_targets[position[reverse.targets[j]]++] = v;
+
+    partition_refinement<std::size_t> classes(initial_order, where);
+    std::vector<std::size_t> result;
+    result.reserve(n);
+    while (classes.size() != 0) {
+        std::size_t v = classes.front();
+        classes.remove(v);
+        result.push_back(v);
+        classes.refine(sorted_targets.begin() + input.offsets[v],
+                       sorted_targets.begin() + input.offsets[v + 1]);
+    }
+    return result;
+}
+
+/*
+Lexicographic breadth-first search on a CSR graph, visiting initial_order.front() first
+Ties are broken in favor of the vertex earliest in initial_order; passing the reverse of a previous
+search gives the LexBFS+ sweep of multi-sweep algorithms (see lex_bfs_plus)
+Throws std::invalid_argument if initial_order is not a permutation of the vertices
+
+Donald Rose, Robert Tarjan, George Lueker
+Algorithmic aspects of vertex elimination on graphs
+(1976) doi:10.1137/0205021
+Partition refinement: Michel Habib, Ross McConnell, Christophe Paul, Laurent Viennot (2000)
+Θ(V+E)
+*/
+template<typename EdgeWeight>
+std::vector<std::size_t> lex_bfs(const util::csr_graph<EdgeWeight>& input,
+                                 const std::vector<std::size_t>& initial_order) {
+    return lexicographic_search(input, initial_order,
+                                partition_refinement<std::size_t>::placement::in_place);
+}
+
+// LexBFS from start, ties broken by smallest id
+template<typename EdgeWeight>
+std::vector<std::size_t> lex_bfs(const util::csr_graph<EdgeWeight>& input,
+                                 std::size_t start = 0) {
+    std::vector<std::size_t> initial_order(input.order());
+    std::iota(initial_order.begin(), initial_order.end(), 0);
+    if (initial_order.empty())
+        return initial_order;
+    if (start >= initial_order.size())
+        throw std::out_of_range("Vertex does not exist");
+    std::rotate(initial_order.begin(), initial_order.begin() + start,
+                initial_order.begin() + start + 1);
+    return lex_bfs(input, initial_order);
+}
+
+/*
+LexBFS+: LexBFS starting from the last vertex of previous, breaking ties in favor of the vertex
+latest in previous
+Derek Corneil
+Lexicographic breadth first search - a survey
+(2004) doi:10.1007/978-3-540-30559-0_1
+Θ(V+E)
+*/
+template<typename EdgeWeight>
+std::vector<std::size_t> lex_bfs_plus(const util::csr_graph<EdgeWeight>& input,
+                                      const std::vector<std::size_t>& previous) {
+    return lex_bfs(input, std::vector<std::size_t>(previous.rbegin(), previous.rend()));
+}
+
+/*
+Lexicographic depth-first search on a CSR graph, visiting initial_order.front() first
+A vertex ranks by the most recently visited of its in-neighbors, then the next most recent, and
+so on; ties are broken in favor of the vertex earliest in initial_order
+Throws std::invalid_argument if initial_order is not a permutation of the vertices
+
+Derek Corneil, Richard Krueger
+A unified view of graph searching
+(2008) doi:10.1137/050623498
+O(V + E log V): the split classes of a step are put in order before moving to the front
+*/
+template<typename EdgeWeight>
+std::vector<std::size_t> lex_dfs(const util::csr_graph<EdgeWeight>& input,
+                                 const std::vector<std::size_t>& initial_order) {
+    return lexicographic_search(input, initial_order,
+                                partition_refinement<std::size_t>::placement::to_front);
+}
+
+// LexDFS from start, ties broken by smallest id
+template<typename EdgeWeight>
+std::vector<std::size_t> lex_dfs(const util::csr_graph<EdgeWeight>& input,
+                                 std::size_t start = 0) {
+    std::vector<std::size_t> initial_order(input.order());
+    std::iota(initial_order.begin(), initial_order.end(), 0);
+    if (initial_order.empty())
+        return initial_order;
+    if (start >= initial_order.size())
+        throw std::out_of_range("Vertex does not exist");
+    std::rotate(initial_order.begin(), initial_order.begin() + start,
+                initial_order.begin() + start + 1);
+    return lex_dfs(input, initial_order);
+}
+
 template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
 std::list<Vertex>
   generate_lex_bfs(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& graph,
                    const Vertex& first_vertex) {
-    if (graph.get_translation().find(first_vertex) == graph.get_translation().end())
+    auto start_it = graph.get_translation().find(first_vertex);
+    if (start_it == graph.get_translation().end())
         throw std::out_of_range("Does not contain given vertex");
 
-    partitioner<Vertex, Directed, Weighted, EdgeWeight, Args...> setup_device(graph);
+    std::vector<Vertex> vertices = graph.vertices();
     std::list<Vertex> result;
-    setup_device.remove_vertex(first_vertex);
-    result.push_back(first_vertex);
-
-    while (result.size() != graph.order()) {
-        // Partition on last vertex added
-        auto ptrs = setup_device.partition(result.back(), false);
-        setup_device.clean(ptrs);
-
-        const std::list<Vertex>& next_set = setup_device.get_all().front();
-
-        // Doesn't matter which one we pick
-        Vertex next = next_set.back();
-        result.push_back(next);
-
-        // Don't want to repeat vertices
-        setup_device.remove_vertex(next);
-    }
-
+    for (std::size_t v : lex_bfs(util::get_csr_rep(graph), start_it->second))
+        result.push_back(vertices[v]);
     return result;
 }
 
@@ -242,6 +448,122 @@ std::list<Vertex>
                               : generate_lex_bfs(graph, graph.get_translation().begin()->first);
 }
 
+template<typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
+std::list<Vertex>
+  generate_lex_dfs(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& graph,
+                   const Vertex& first_vertex) {
+    auto start_it = graph.get_translation().find(first_vertex);
+    if (start_it == graph.get_translation().end())
+        throw std::out_of_range("Does not contain given vertex");
+
+    std::vector<Vertex> vertices = graph.vertices();
+    std::list<Vertex> result;
+    for (std::size_t v : lex_dfs(util::get_csr_rep(graph), start_it->second))
+        result.push_back(vertices[v]);
+    return result;
+}
+
+/*
+Topological order of a directed acyclic graph on dense ids, split into levels
+Level 0 holds the sources, and every other vertex is in the level after its last predecessor, so
+the vertices of a level are independent of each other
+*/
+struct topological_levels {
+    std::vector<std::size_t> order;         // level i is [level_offsets[i], level_offsets[i + 1])
+    std::vector<std::size_t> level_offsets;
+
+    std::size_t num_levels() const noexcept {
+        return level_offsets.empty() ? 0 : level_offsets.size() - 1;
+    }
+};
+
+/*
+Kahn's algorithm on a CSR graph, one wavefront at a time
+Throws std::invalid_argument if input is not directed acyclic
+The vertices of a level are released on num_threads threads (0: all hardware threads) through
+atomic in-degree counters; the order within a level is then unspecified
+Arthur B. Kahn
+Topological sorting of large networks
+(1962) doi:10.1145/368996.369025
+Θ(V+E)
+*/
+template<typename EdgeWeight>
+topological_levels Kahn_levels(const util::csr_graph<EdgeWeight>& input,
+                               unsigned num_threads = 1) {
+    const std::size_t GRAIN = 1024;
+    std::size_t n = input.order();
+    topological_levels result;
+    result.order.reserve(n);
+    result.level_offsets.push_back(0);
+
+    if (util::thread_count(num_threads) == 1) {
+        std::vector<std::size_t> in_degree(n, 0);
+        for (std::size_t target : input.targets)
+            ++in_degree[target];
+        for (std::size_t v = 0; v < n; ++v)
+            if (in_degree[v] == 0)
+                result.order.push_back(v);
+
+        for (std::size_t begin = 0; begin != result.order.size();) {
+            std::size_t end = result.order.size();
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t v = result.order[i];
+                for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                    if (--in_degree[input.targets[j]] == 0)
+                        result.order.push_back(input.targets[j]);
+            }
+            result.level_offsets.push_back(end);
+            begin = end;
+        }
+    } else {
+        unsigned threads = util::thread_count(num_threads);
+        std::vector<std::atomic<std::size_t>> in_degree(n);
+        std::vector<std::vector<std::size_t>> released(threads);
+        util::parallel_for(
+          0, n, threads,
+          [&in_degree](unsigned, std::size_t v) {
+              in_degree[v].store(0, std::memory_order_relaxed);
+          },
+          GRAIN);
+        util::parallel_for(
+          0, n, threads,
+          [&](unsigned, std::size_t v) {
+              for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                  in_degree[input.targets[j]].fetch_add(1, std::memory_order_relaxed);
+          },
+          GRAIN);
+        for (std::size_t v = 0; v < n; ++v)
+            if (in_degree[v].load(std::memory_order_relaxed) == 0)
+                result.order.push_back(v);
+
+        for (std::size_t begin = 0; begin != result.order.size();) {
+            std::size_t end = result.order.size();
+            // the last decrement of a vertex releases it into the next level
+            util::parallel_for(
+              begin, end, threads,
+              [&](unsigned id, std::size_t i) {
+                  std::size_t v = result.order[i];
+                  for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                      std::size_t w = input.targets[j];
+                      if (in_degree[w].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                          released[id].push_back(w);
+                  }
+              },
+              GRAIN);
+            for (std::vector<std::size_t>& local : released) {
+                result.order.insert(result.order.end(), local.begin(), local.end());
+                local.clear();
+            }
+            result.level_offsets.push_back(end);
+            begin = end;
+        }
+    }
+
+    if (result.order.size() != n)
+        throw std::invalid_argument("Not DAG");
+    return result;
+}
+
 /*
 Returns a topological sort of the input graph
 Throws if input is not directed acyclic.
@@ -253,37 +575,13 @@ Topological sorting of large networks
 template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
 std::vector<Vertex>
   topological_sort(const graph::graph<Vertex, true, Weighted, EdgeWeight, Args...>& src) {
-    std::unordered_map<Vertex, uint32_t, Args...> in_degree;
-    std::list<Vertex> candidates; // vertices with in-degree 0
-    std::vector<Vertex> result;   // stores topological sort
-
-    // populate map
-    for (const Vertex& vert : src.vertices())
-        in_degree[vert] = 0;
-
-    // correct map values
-    for (const Vertex& source : src.vertices())
-        for (const Vertex& terminal : src.neighbors(source))
-            ++in_degree[terminal];
-
-    for (const std::pair<Vertex, uint32_t>& value : in_degree)
-        if (value.second == 0)
-            candidates.push_back(value.first);
-
-    while (!candidates.empty()) {
-        Vertex current = candidates.front();
-        candidates.pop_front();
-        result.push_back(current);
-        for (const Vertex& terminal : src.neighbors(current)) {
-            --in_degree[terminal];
-            if (in_degree[terminal] == 0)
-                candidates.push_back(terminal);
-        }
-    }
-
-    if (result.size() != src.order())
-        throw std::invalid_argument("Not DAG");
+    std::vector<Vertex> vertices = src.vertices();
+    topological_levels levels = Kahn_levels(util::get_csr_rep(src));
 
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+    for (std::size_t v : levels.order)
+        result.push_back(vertices[v]);
     return result;
 }
 } // namespace graph_alg
@@ -5,6 +5,8 @@
 #ifndef GRAPH_ALG_SPANNING_TREE_H
 #define GRAPH_ALG_SPANNING_TREE_H
 
+#include <atomic>
+#include <numeric>
 #include <set>
 
 #include <sequence/order_stats.h>
@@ -13,6 +15,9 @@
 #include <structures/graph.h>
 #include <structures/heap>
 
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
 #include "components.h"
 
 /**
@@ -30,66 +35,202 @@ namespace graph_alg {
 template<typename Vertex, typename EdgeWeight, typename... Args>
 graph::graph<Vertex, false, true, EdgeWeight, Args...>
   minimum_spanning_Boruvka(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& input) {
-    struct edge_info {
-        Vertex start;
-        Vertex terminal;
-        EdgeWeight weight;
-    };
-
+    const std::size_t NONE = -1;
     std::vector<Vertex> input_vertices = input.vertices();
-    uint32_t num_input_components = connected_components(input).size();
+    std::size_t n = input_vertices.size();
+
+    // edges still leaving the subtree of vertex v are kept in offsets[v] - (list_end[v] - 1)
+    util::csr_graph<EdgeWeight> adjacency = util::get_csr_rep(input);
+    std::vector<std::size_t> list_end(adjacency.offsets.begin() + 1, adjacency.offsets.end());
+
+    // ties are broken by endpoints, so that the candidates of a round never form a cycle
+    auto lighter = [](EdgeWeight w1, std::size_t u1, std::size_t v1, EdgeWeight w2,
+                      std::size_t u2, std::size_t v2) {
+        if (w1 < w2 || w2 < w1)
+            return w1 < w2;
+        return std::minmax(u1, v1) < std::minmax(u2, v2);
+    };
 
     graph::graph<Vertex, false, true, EdgeWeight, Args...> result;
-    disjoint_set<Vertex, Args...> tree_components;
-    std::unordered_map<Vertex, std::list<std::pair<Vertex, EdgeWeight>>, Args...>
-      mutable_list; // need to be able to iterate through and delete edges quickly
-
-    for (Vertex& v : input_vertices) {
+    for (const Vertex& v : input_vertices)
         result.add_vertex(v);
-        tree_components.insert(v);
-        mutable_list[v] = input.edges(v);
-    }
 
-    while (tree_components.num_sets() > num_input_components) {
-        std::unordered_map<Vertex, edge_info, Args...> to_add;
-        for (const Vertex& v : input_vertices) {
+    dense_disjoint_set<> tree_components(n);
+    std::vector<std::pair<std::size_t, std::size_t>> to_add(n, std::make_pair(NONE, NONE));
+    std::vector<std::size_t> candidate_roots;
+    do {
+        candidate_roots.clear();
+        for (std::size_t v = 0; v < n; ++v) {
             // Each iteration, add shortest edge out of every subtree
-            // Since we iterate over all vertices every time, depth of UNION-FIND tree<=3
-            // So find() is essentially constant
-            Vertex component_root = tree_components.find(v);
-            std::list<std::pair<Vertex, EdgeWeight>>& edge_list = mutable_list[v];
-
-            for (auto it = edge_list.begin(); it != edge_list.end();)
-                if (component_root == tree_components.find(it->first))
-                    it = edge_list.erase(it);
-                else
-                    ++it;
-
-            if (!mutable_list[v].empty()) {
-                std::pair<Vertex, EdgeWeight> least_weight_edge = *std::min_element(
-                  edge_list.begin(), edge_list.end(),
-                  [](const std::pair<Vertex, EdgeWeight>& x,
-                     const std::pair<Vertex, EdgeWeight>& y) { return x.second < y.second; });
-                edge_info candidate{v, least_weight_edge.first, least_weight_edge.second};
-
-                // check that it is the smallest out of current set so far
-                if (to_add.find(component_root) == to_add.end() ||
-                    candidate.weight < to_add[component_root].weight)
-                    to_add[component_root] = std::move(candidate);
+            std::size_t component_root = tree_components.find(v);
+            std::size_t kept = adjacency.offsets[v];
+            for (std::size_t j = adjacency.offsets[v]; j < list_end[v]; ++j)
+                if (tree_components.find(adjacency.targets[j]) != component_root) {
+                    std::swap(adjacency.targets[j], adjacency.targets[kept]);
+                    std::swap(adjacency.weights[j], adjacency.weights[kept]);
+                    ++kept;
+                }
+            list_end[v] = kept;
+
+            // check that it is the smallest out of current set so far
+            std::pair<std::size_t, std::size_t>& best = to_add[component_root];
+            for (std::size_t j = adjacency.offsets[v]; j < list_end[v]; ++j) {
+                if (best.first == NONE)
+                    candidate_roots.push_back(component_root);
+                else if (!lighter(adjacency.weights[j], v, adjacency.targets[j],
+                                  adjacency.weights[best.second], best.first,
+                                  adjacency.targets[best.second]))
+                    continue;
+                best = std::make_pair(v, j);
             }
         }
 
         // add edges and update connected components
-        for (const std::pair<Vertex, edge_info>& candidate : to_add)
-            if (tree_components.find(candidate.second.start) !=
-                tree_components.find(candidate.second.terminal)) {
-                result.force_add(candidate.second.start, candidate.second.terminal,
-                                 candidate.second.weight);
-                tree_components.union_sets(candidate.second.start, candidate.second.terminal);
-            }
+        for (std::size_t root : candidate_roots) {
+            auto [v, j] = to_add[root];
+            if (tree_components.union_sets(v, adjacency.targets[j]))
+                result.force_add(input_vertices[v], input_vertices[adjacency.targets[j]],
+                                 adjacency.weights[j]);
+            to_add[root] = std::make_pair(NONE, NONE);
+        }
+    } while (!candidate_roots.empty());
+    return result;
+}
+/*
+ * Minimum spanning forest of a graph given as an edge array on vertices 0 - (num_vertices - 1)
+ * Returns the indices of the forest edges
+ *
+ * Every round, each component picks its lightest outgoing edge (ties broken by index, so the
+ * picks never form a cycle) with an atomic compare-and-swap minimum, and is joined along it in a
+ * concurrent_disjoint_set; of two components picking the same edge, only one union succeeds.
+ * Edges inside a component are then filtered out. All steps run on num_threads threads
+ * (0: all hardware threads)
+ *
+ * David A. Bader, Guojing Cong
+ * Fast shared-memory algorithms for computing the minimum spanning forest of sparse graphs
+ * (2006) Journal of Parallel and Distributed Computing 66(11)
+ * O(log V) rounds, O(E log V) work
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> Boruvka_forest(std::size_t num_vertices,
+                                        const util::edge_array<EdgeWeight>& input,
+                                        unsigned num_threads = 1) {
+    const std::size_t NONE = -1;
+    unsigned threads = util::thread_count(num_threads);
+    auto lighter = [&input](std::size_t x, std::size_t y) {
+        return input.weights[x] < input.weights[y] ||
+               (!(input.weights[y] < input.weights[x]) && x < y);
+    };
+
+    // label: component root of each vertex, fixed within a round
+    concurrent_disjoint_set<> components(num_vertices);
+    std::vector<std::size_t> label(num_vertices), roots(num_vertices);
+    std::iota(label.begin(), label.end(), 0);
+    std::iota(roots.begin(), roots.end(), 0);
+    std::vector<std::atomic<std::size_t>> best(num_vertices);
+    for (std::size_t v = 0; v < num_vertices; ++v)
+        best[v].store(NONE, std::memory_order_relaxed);
+
+    std::vector<std::size_t> active, result;
+    for (std::size_t i = 0; i < input.size(); ++i)
+        if (input.endpoints[i].first != input.endpoints[i].second)
+            active.push_back(i);
+    std::vector<std::vector<std::size_t>> buffers(threads);
+    auto gather = [&buffers](std::vector<std::size_t>& output) {
+        for (std::vector<std::size_t>& buffer : buffers) {
+            output.insert(output.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+    };
+
+    while (!active.empty()) {
+        // lightest edge out of every component
+        util::parallel_blocks(
+          0, active.size(), threads,
+          [&](unsigned, std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i) {
+                  std::size_t e = active[i];
+                  for (std::size_t r : {label[input.endpoints[e].first],
+                                        label[input.endpoints[e].second]}) {
+                      std::size_t current = best[r].load(std::memory_order_relaxed);
+                      while ((current == NONE || lighter(e, current)) &&
+                             !best[r].compare_exchange_weak(
+                               current, e, std::memory_order_relaxed))
+                          ;
+                  }
+              }
+          });
+
+        // join each component along its edge
+        util::parallel_blocks(
+          0, roots.size(), threads,
+          [&](unsigned id, std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i) {
+                  std::size_t e = best[roots[i]].load(std::memory_order_relaxed);
+                  if (e != NONE &&
+                      components.union_sets(input.endpoints[e].first, input.endpoints[e].second))
+                      buffers[id].push_back(e);
+              }
+          });
+        gather(result);
+
+        util::parallel_blocks(
+          0, num_vertices, threads,
+          [&](unsigned, std::size_t begin, std::size_t end) {
+              for (std::size_t v = begin; v < end; ++v)
+                  label[v] = components.find(label[v]);
+          });
+
+        // surviving roots that still have outgoing edges take part in the next round
+        util::parallel_blocks(
+          0, roots.size(), threads,
+          [&](unsigned id, std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i) {
+                  std::size_t r = roots[i];
+                  if (label[r] == r && best[r].load(std::memory_order_relaxed) != NONE)
+                      buffers[id].push_back(r);
+              }
+          });
+        roots.clear();
+        gather(roots);
+        for (std::size_t r : roots)
+            best[r].store(NONE, std::memory_order_relaxed);
+
+        util::parallel_blocks(
+          0, active.size(), threads,
+          [&](unsigned id, std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i) {
+                  std::size_t e = active[i];
+                  if (label[input.endpoints[e].first] != label[input.endpoints[e].second])
+                      buffers[id].push_back(e);
+              }
+          });
+        active.clear();
+        gather(active);
     }
+
     return result;
 }
+
+/*
+ * Multithreaded Borůvka on num_threads threads (0: all hardware threads); see Boruvka_forest
+ */
+template<typename Vertex, typename EdgeWeight, typename... Args>
+graph::graph<Vertex, false, true, EdgeWeight, Args...>
+  minimum_spanning_Boruvka(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& input,
+                           unsigned num_threads) {
+    std::vector<Vertex> vertices = input.vertices();
+    util::edge_array<EdgeWeight> edges = util::get_edge_array(input);
+
+    graph::graph<Vertex, false, true, EdgeWeight, Args...> result;
+    for (const Vertex& v : vertices)
+        result.add_vertex(v);
+    for (std::size_t e : Boruvka_forest(vertices.size(), edges, num_threads))
+        result.force_add(vertices[edges.endpoints[e].first], vertices[edges.endpoints[e].second],
+                         edges.weights[e]);
+    return result;
+}
+
 /*
 template <typename Vertex, typename EdgeWeight, typename... Args>
 graph::graph<Vertex, false, true, EdgeWeight, Args...> minimum_spanning_Boruvka(
@@ -198,58 +339,163 @@ template<typename Vertex, typename EdgeWeight, typename... Args>
 graph::graph<Vertex, false, true, EdgeWeight, Args...>
   minimum_spanning_Kruskal(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& input) {
     std::vector<Vertex> vertices = input.vertices();
+    util::edge_array<EdgeWeight> edges = util::get_edge_array(input);
 
-    struct edge {
-        Vertex start;
-        Vertex terminal;
-        EdgeWeight weight;
-    };
-    std::unordered_set<Vertex, Args...> processed_vertices; // used to prevent double-counting edges
-
-    auto edge_compare = [](const edge& x, const edge& y) {
-        return x.weight < y.weight;
-    };
-    std::vector<edge> edges; // all edges, ordered by weight
-    edges.reserve(vertices.size());
+    std::vector<std::size_t> order(edges.size()); // all edges, ordered by weight
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&edges](std::size_t x, std::size_t y) {
+        return edges.weights[x] < edges.weights[y];
+    });
 
     graph::graph<Vertex, false, true, EdgeWeight, Args...> result;
-
-    for (const Vertex& vertex : vertices) {
+    for (const Vertex& vertex : vertices)
         result.add_vertex(vertex);
-        processed_vertices.insert(vertex);
-
-        // insert all edges into set
-        for (const std::pair<Vertex, EdgeWeight>& curr_edge : input.edges(vertex))
-            if (processed_vertices.find(curr_edge.first) == processed_vertices.end()) {
-                edge current;
-                current.start = vertex;
-                current.terminal = curr_edge.first;
-                current.weight = curr_edge.second;
-                edges.push_back(current);
-            }
+
+    // only add edges between disjoint components: use disjoint set and union-find
+    dense_disjoint_set<> components(vertices.size());
+    std::size_t tree_edges = 0;
+    for (std::size_t e : order) {
+        if (tree_edges + 1 >= vertices.size())
+            break;
+
+        if (components.union_sets(edges.endpoints[e].first, edges.endpoints[e].second)) {
+            result.force_add(vertices[edges.endpoints[e].first],
+                             vertices[edges.endpoints[e].second], edges.weights[e]);
+            ++tree_edges;
+        }
     }
 
-    std::sort(edges.begin(), edges.end(), edge_compare);
+    return result;
+}
 
-    disjoint_set<Vertex> components(vertices.begin(), vertices.end());
-    uint32_t num_input_components = graph_alg::connected_components(input).size();
+/*
+ * Minimum spanning forest of a graph given as an edge array on vertices 0 - (num_vertices - 1)
+ * Returns the indices of the forest edges, in increasing order of weight
+ *
+ * Quicksort-style: edges are partitioned around a sampled pivot, the light half is solved first,
+ * and edges of the heavy half that already lie inside a component are discarded before it is
+ * partitioned or sorted. Sorting, partitioning and filtering run on num_threads threads
+ * (0: all hardware threads); UNION-FIND is a dense_disjoint_set
+ *
+ * Vitaly Osipov, Peter Sanders, Johannes Singler
+ * The Filter-Kruskal minimum spanning tree algorithm
+ * (2009) doi:10.1137/1.9781611972894.5
+ * O(E + V log V log(E/V)) expected on random weights
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> Filter_Kruskal_forest(std::size_t num_vertices,
+                                               const util::edge_array<EdgeWeight>& input,
+                                               unsigned num_threads = 1) {
+    const std::size_t SAMPLE_SIZE = 31;
+    unsigned threads = util::thread_count(num_threads);
+    auto lighter = [&input](std::size_t x, std::size_t y) {
+        return input.weights[x] < input.weights[y] ||
+               (!(input.weights[y] < input.weights[x]) && x < y);
+    };
 
-    // only add edges between disjoint components: use disjoint set and union-find
-    for (const edge& current : edges) {
-        if (components.size() == num_input_components)
-            break;
+    dense_disjoint_set<> components(num_vertices);
+    std::vector<std::size_t> edges(input.size()), buffer(input.size()), result;
+    std::iota(edges.begin(), edges.end(), 0);
+
+    // stable parallel partition of edges[begin, end): elements satisfying pred first
+    std::vector<std::size_t> block_begin(threads), block_end(threads), block_count(threads);
+    std::vector<std::size_t> accepted(threads), rejected(threads);
+    auto partition = [&](std::size_t begin, std::size_t end, auto pred) {
+        std::fill(block_begin.begin(), block_begin.end(), begin);
+        std::fill(block_end.begin(), block_end.end(), begin);
+        std::fill(block_count.begin(), block_count.end(), 0);
+        util::parallel_blocks(
+          begin, end, threads, [&](unsigned id, std::size_t first, std::size_t last) {
+              block_begin[id] = first;
+              block_end[id] = last;
+              for (std::size_t i = first; i < last; ++i)
+                  block_count[id] += pred(edges[i]);
+          });
+
+        std::size_t split = begin;
+        for (unsigned id = 0; id < threads; ++id)
+            split += block_count[id];
+        std::size_t next_accepted = begin, next_rejected = split;
+        for (unsigned id = 0; id < threads; ++id) {
+            accepted[id] = next_accepted;
+            rejected[id] = next_rejected;
+            next_accepted += block_count[id];
+            next_rejected += block_end[id] - block_begin[id] - block_count[id];
+        }
+
+        util::parallel_blocks(
+          begin, end, threads, [&](unsigned id, std::size_t first, std::size_t last) {
+              for (std::size_t i = first; i < last; ++i)
+                  buffer[pred(edges[i]) ? accepted[id]++ : rejected[id]++] = edges[i];
+          });
+        util::parallel_blocks(begin, end, threads,
+                              [&](unsigned, std::size_t first, std::size_t last) {
+                                  std::copy(buffer.begin() + first, buffer.begin() + last,
+                                            edges.begin() + first);
+                              });
+        return split;
+    };
 
-        Vertex root_a = components.find(current.start);
-        Vertex root_b = components.find(current.terminal);
-        if (root_a != root_b) {
-            result.force_add(current.start, current.terminal, current.weight);
-            components.union_sets(root_a, root_b);
+    // ranges of edges still to process, lightest on top; heavier ranges are filtered first
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(1, std::make_pair(0, edges.size()));
+    bool first_range = true;
+    while (!ranges.empty() && result.size() + 1 < num_vertices) {
+        auto [begin, end] = ranges.back();
+        ranges.pop_back();
+        if (!first_range)
+            end = partition(begin, end, [&](std::size_t e) {
+                return components.root(input.endpoints[e].first) !=
+                       components.root(input.endpoints[e].second);
+            });
+        first_range = false;
+
+        if (end - begin <= std::max<std::size_t>(num_vertices, SAMPLE_SIZE * SAMPLE_SIZE)) {
+            util::parallel_sort(edges.begin() + begin, edges.begin() + end, threads, lighter);
+            for (std::size_t i = begin; i < end && result.size() + 1 < num_vertices; ++i) {
+                std::size_t e = edges[i];
+                if (!components.union_sets(input.endpoints[e].first, input.endpoints[e].second))
+                    continue;
+                result.push_back(e);
+            }
+            continue;
         }
+
+        // pivot: median of an evenly spaced sample, under the (weight, index) total order
+        std::vector<std::size_t> sample(SAMPLE_SIZE);
+        for (std::size_t i = 0; i < SAMPLE_SIZE; ++i)
+            sample[i] = edges[begin + (end - begin) * i / SAMPLE_SIZE];
+        std::nth_element(sample.begin(), sample.begin() + SAMPLE_SIZE / 2, sample.end(), lighter);
+        std::size_t pivot = sample[SAMPLE_SIZE / 2];
+        std::size_t split =
+          partition(begin, end, [&](std::size_t e) { return !lighter(pivot, e); });
+
+        ranges.emplace_back(split, end);
+        ranges.emplace_back(begin, split);
+        first_range = true;
     }
 
     return result;
 }
 
+/*
+ * Filter-Kruskal on num_threads threads (0: all hardware threads); see Filter_Kruskal_forest
+ */
+template<typename Vertex, typename EdgeWeight, typename... Args>
+graph::graph<Vertex, false, true, EdgeWeight, Args...>
+  minimum_spanning_Kruskal(const graph::graph<Vertex, false, true, EdgeWeight, Args...>& input,
+                           unsigned num_threads) {
+    std::vector<Vertex> vertices = input.vertices();
+    util::edge_array<EdgeWeight> edges = util::get_edge_array(input);
+
+    graph::graph<Vertex, false, true, EdgeWeight, Args...> result;
+    for (const Vertex& v : vertices)
+        result.add_vertex(v);
+    for (std::size_t e : Filter_Kruskal_forest(vertices.size(), edges, num_threads))
+        result.force_add(vertices[edges.endpoints[e].first], vertices[edges.endpoints[e].second],
+                         edges.weights[e]);
+    return result;
+}
+
 /*
  * Andrew Chi-Chih Yao (姚期智)
  * An O(|E|loglog|V|) algorithm for finding minimum spanning trees
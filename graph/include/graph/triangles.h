@@ -0,0 +1,273 @@
+#ifndef GRAPH_TRIANGLES_H
+#define GRAPH_TRIANGLES_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+namespace graph_alg {
+/*
+ * Triangle counting on undirected graphs in CSR form (both directions of every edge stored);
+ * self-loops and parallel edges are ignored
+ * Every edge is oriented towards its endpoint of higher (degree, id) rank, so that each triangle
+ * is found exactly once, from its lowest vertex, by intersecting two sorted forward lists; no
+ * vertex has more than √(2E) forward neighbors
+ *
+ * Thomas Schank, Dorothea Wagner
+ * Finding, counting and listing all triangles in large graphs, an experimental study
+ * (2005) doi:10.1007/11427186_54
+ */
+
+// Common elements of two strictly increasing lists, each passed to on_common; returns their number
+// With SSE2, blocks of four are compared all-against-all through three rotations of one side
+template<typename Found>
+static std::size_t intersect_sorted(const std::uint32_t* a, const std::uint32_t* a_end,
+                                    const std::uint32_t* b, const std::uint32_t* b_end,
+                                    Found on_common) {
+    std::size_t count = 0;
+#ifdef __SSE2__
+    while (a_end - a >= 4 && b_end - b >= 4) {
+        __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+        __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+        __m128i equal = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi32(left, right),
+                       _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, 0x39))),
+          _mm_or_si128(_mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, 0x4E)),
+                       _mm_cmpeq_epi32(left, _mm_shuffle_epi32(right, 0x93))));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+        count += std::popcount(mask);
+        for (; mask != 0; mask &= mask - 1)
+            on_common(a[std::countr_zero(mask)]);
+
+        std::uint32_t a_last = a[3], b_last = b[3];
+        if (a_last <= b_last)
+            a += 4;
+        if (b_last <= a_last)
+            b += 4;
+    }
+#endif
+    while (a != a_end && b != b_end) {
+        if (*a < *b) {
+            ++a;
+        } else if (*b < *a) {
+            ++b;
+        } else {
+            on_common(*a);
+            ++count;
+            ++a;
+            ++b;
+        }
+    }
+    return count;
+}
+
+/*
+ * Edges oriented by (degree, id) rank, on vertices renumbered by rank: list r holds the ranks of
+ * the neighbors of vertex[r] above r, ascending. degree is the number of distinct neighbors of
+ * every vertex other than itself, by original id
+ * O(V log V + E log Δ)
+ */
+struct forward_adjacency {
+    std::vector<std::size_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<std::size_t> vertex, degree;
+
+    std::size_t order() const noexcept { return vertex.size(); }
+    const std::uint32_t* begin(std::size_t r) const noexcept { return targets.data() + offsets[r]; }
+    const std::uint32_t* end(std::size_t r) const noexcept {
+        return targets.data() + offsets[r + 1];
+    }
+};
+
+template<typename EdgeWeight>
+forward_adjacency forward_orientation(const util::csr_graph<EdgeWeight>& input,
+                                      unsigned num_threads = 1) {
+    std::size_t n = input.order();
+    if (n > std::numeric_limits<std::uint32_t>::max())
+        throw std::overflow_error("Too many vertices for 32-bit ids");
+    unsigned threads = util::thread_count(num_threads);
+    forward_adjacency result;
+
+    // distinct neighbors at the front of every list
+    std::vector<std::size_t> neighbors(input.targets.begin(), input.targets.end());
+    result.degree.assign(n, 0);
+    util::parallel_for(
+      0, n, threads,
+      [&](unsigned, std::size_t v) {
+          auto first = neighbors.begin() + input.offsets[v];
+          auto last = std::remove(first, neighbors.begin() + input.offsets[v + 1], v);
+          std::sort(first, last);
+          result.degree[v] = std::unique(first, last) - first;
+      },
+      256);
+
+    result.vertex.resize(n);
+    for (std::size_t v = 0; v < n; ++v)
+        result.vertex[v] = v;
+    util::parallel_sort(result.vertex.begin(), result.vertex.end(), threads,
+                        [&result](std::size_t u, std::size_t v) {
+                            return result.degree[u] < result.degree[v] ||
+                                   (result.degree[u] == result.degree[v] && u < v);
+                        });
+    std::vector<std::uint32_t> rank(n);
+    for (std::size_t r = 0; r < n; ++r)
+        rank[result.vertex[r]] = static_cast<std::uint32_t>(r);
+
+    result.offsets.assign(n + 1, 0);
+    util::parallel_for(
+      0, n, threads,
+      [&](unsigned, std::size_t r) {
+          std::size_t v = result.vertex[r];
+          for (std::size_t j = input.offsets[v]; j < input.offsets[v] + result.degree[v]; ++j)
+              result.offsets[r + 1] += rank[neighbors[j]] > r;
+      },
+      256);
+    for (std::size_t r = 0; r < n; ++r)
+        result.offsets[r + 1] += result.offsets[r];
+
+    result.targets.resize(result.offsets[n]);
+    util::parallel_for(
+      0, n, threads,
+      [&](unsigned, std::size_t r) {
+          std::size_t v = result.vertex[r], k = result.offsets[r];
+          for (std::size_t j = input.offsets[v]; j < input.offsets[v] + result.degree[v]; ++j)
+              if (rank[neighbors[j]] > r)
+                  result.targets[k++] = rank[neighbors[j]];
+          std::sort(result.targets.begin() + result.offsets[r], result.targets.begin() + k);
+      },
+      256);
+    return result;
+}
+
+/*
+ * Number of triangles, on num_threads threads (0: all hardware threads)
+ * Vertices are claimed dynamically, as the work per vertex is very uneven
+ * O(E^1.5)
+ */
+template<typename EdgeWeight>
+std::size_t count_triangles(const util::csr_graph<EdgeWeight>& input, unsigned num_threads = 1) {
+    unsigned threads = util::thread_count(num_threads);
+    forward_adjacency forward = forward_orientation(input, threads);
+
+    std::vector<std::size_t> partial(threads, 0);
+    util::parallel_for(
+      0, forward.order(), threads,
+      [&](unsigned id, std::size_t r) {
+          // forward neighbors of s are all above s
+          for (const std::uint32_t* s = forward.begin(r); s != forward.end(r); ++s)
+              partial[id] += intersect_sorted(s + 1, forward.end(r), forward.begin(*s),
+                                              forward.end(*s), [](std::uint32_t) {});
+      },
+      64);
+
+    std::size_t total = 0;
+    for (std::size_t count : partial)
+        total += count;
+    return total;
+}
+
+/*
+ * Triangles through every vertex, and its local clustering coefficient: the fraction of pairs of
+ * its distinct neighbors that are adjacent (0 with fewer than two neighbors)
+ *
+ * Duncan Watts, Steven Strogatz
+ * Collective dynamics of 'small-world' networks
+ * (1998) doi:10.1038/30918
+ */
+struct triangle_census {
+    std::size_t total = 0;
+    std::vector<std::size_t> per_vertex;
+    std::vector<double> clustering;
+
+    // Fraction of paths of length two that are closed: 3 * triangles / paths
+    double transitivity = 0;
+};
+
+/*
+ * Per-vertex counts on num_threads threads (0: all hardware threads): every thread accumulates
+ * into its own array, and the arrays are summed afterwards
+ * O(E^1.5), memory O(threads * V)
+ */
+template<typename EdgeWeight>
+triangle_census count_triangles_per_vertex(const util::csr_graph<EdgeWeight>& input,
+                                           unsigned num_threads = 1) {
+    unsigned threads = util::thread_count(num_threads);
+    forward_adjacency forward = forward_orientation(input, threads);
+    std::size_t n = forward.order();
+
+    // by rank
+    std::vector<std::vector<std::size_t>> partial(threads, std::vector<std::size_t>(n, 0));
+    std::vector<std::size_t> partial_total(threads, 0);
+    util::parallel_for(
+      0, n, threads,
+      [&](unsigned id, std::size_t r) {
+          std::vector<std::size_t>& count = partial[id];
+          for (const std::uint32_t* s = forward.begin(r); s != forward.end(r); ++s) {
+              std::size_t found =
+                intersect_sorted(s + 1, forward.end(r), forward.begin(*s), forward.end(*s),
+                                 [&count](std::uint32_t w) { ++count[w]; });
+              count[r] += found;
+              count[*s] += found;
+              partial_total[id] += found;
+          }
+      },
+      64);
+
+    triangle_census result;
+    result.per_vertex.assign(n, 0);
+    result.clustering.assign(n, 0);
+    util::parallel_blocks(0, n, threads, [&](unsigned, std::size_t first, std::size_t last) {
+        for (std::size_t r = first; r < last; ++r) {
+            std::size_t v = forward.vertex[r], triangles = 0;
+            for (const std::vector<std::size_t>& count : partial)
+                triangles += count[r];
+            result.per_vertex[v] = triangles;
+            std::size_t d = forward.degree[v];
+            if (d >= 2)
+                result.clustering[v] = 2.0 * triangles / (static_cast<double>(d) * (d - 1));
+        }
+    });
+
+    double paths = 0;
+    for (std::size_t d : forward.degree)
+        paths += static_cast<double>(d) * (static_cast<double>(d) - 1) / 2;
+    for (std::size_t count : partial_total)
+        result.total += count;
+    result.transitivity = paths == 0 ? 0 : 3.0 * result.total / paths;
+    return result;
+}
+
+// Vertex names, numbered as in src.get_translation()
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::size_t count_triangles(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src,
+                            unsigned num_threads = 1) {
+    return count_triangles(util::get_csr_rep(src), num_threads);
+}
+
+template<typename Vertex, bool Weighted, typename EdgeWeight, typename... Args>
+std::unordered_map<Vertex, double, Args...>
+  clustering_coefficients(const graph::graph<Vertex, false, Weighted, EdgeWeight, Args...>& src,
+                          unsigned num_threads = 1) {
+    triangle_census census = count_triangles_per_vertex(util::get_csr_rep(src), num_threads);
+    std::vector<Vertex> vertices = src.vertices();
+    std::unordered_map<Vertex, double, Args...> result;
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+        result.emplace(vertices[v], census.clustering[v]);
+    return result;
+}
+} // namespace graph_alg
+
+#endif // GRAPH_TRIANGLES_H
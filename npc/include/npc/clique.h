@@ -0,0 +1,423 @@
+#ifndef NPC_CLIQUE_H
+#define NPC_CLIQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+namespace NP_complete {
+/*
+ * Exact maximum clique by branch and bound over bitsets
+ *
+ * Vertices are renumbered in smallest-last order (as in MCS), and the adjacency of every vertex
+ * is a row of n bits. A search node holds a clique C and the bitset P of vertices adjacent to all
+ * of C; P is colored greedily one color class at a time (every class is what remains of P after
+ * removing the neighbors of the vertices taken), and C plus the vertices of k colors is at most
+ * |C| + k. Vertices are branched on from the highest color down, and only those whose color can
+ * still beat the best clique found; those are first renumbered into a lower class when possible
+ *
+ * The branches on the vertices of the whole graph are independent, and are claimed dynamically by
+ * num_threads threads (0: all hardware threads) that share the size of the best clique. Once they
+ * run out, a thread with idle peers hands its pending branches of depth 1 - 2 to a shared queue
+ * instead of searching them itself, so a few large subtrees at the end are split among all threads
+ *
+ * This is still exponential, and large dense graphs are out of reach: a maximum clique of
+ * G(1000, 0.4) takes 6 - 7 s on one thread, and G(2000, 0.5) does not finish in two minutes;
+ * threads divide the time at best
+ *
+ * Pablo San Segundo, Diego Rodríguez-Losada, Agustín Jiménez
+ * An exact bit-parallel algorithm for the maximum clique problem
+ * (2011) doi:10.1016/j.cor.2010.07.019
+ * Etsuji Tomita, Toshikatsu Kameda
+ * An efficient branch-and-bound algorithm for finding a maximum clique with computational
+ * experiments
+ * (2007) doi:10.1007/s10898-006-9039-7
+ * O(2^V) worst case; memory O(V^2/64) words
+ */
+class bit_clique_search {
+    public:
+    // Cliques of the graph, or with complement its independent sets; the search stops as soon as
+    // a clique of target vertices is found
+    template<typename EdgeWeight>
+    bit_clique_search(const util::csr_graph<EdgeWeight>& input, bool complement,
+                      std::size_t target) :
+        _n(input.order()),
+        _words((_n + 63) / 64),
+        _target(target),
+        _best_size(0),
+        _next_root(0),
+        _active(0),
+        _idle(0),
+        _queued(0) {
+        std::vector<std::size_t> degree(_n, 0);
+        std::vector<std::vector<std::uint64_t>> rows(_n, std::vector<std::uint64_t>(_words, 0));
+        for (std::size_t v = 0; v < _n; ++v) {
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j) {
+                std::size_t w = input.targets[j];
+                if (w != v)
+                    rows[v][w / 64] |= std::uint64_t(1) << (w % 64);
+            }
+            if (complement) {
+                for (std::size_t i = 0; i < _words; ++i)
+                    rows[v][i] = ~rows[v][i];
+                if (_n % 64 != 0)
+                    rows[v][_words - 1] &= (std::uint64_t(1) << (_n % 64)) - 1;
+                rows[v][v / 64] &= ~(std::uint64_t(1) << (v % 64));
+            }
+            for (std::uint64_t word : rows[v])
+                degree[v] += std::popcount(word);
+        }
+
+        // smallest last: repeatedly remove a vertex of least remaining degree, the last first
+        std::vector<bool> removed(_n, false);
+        _vertex.resize(_n);
+        for (std::size_t r = _n; r-- > 0;) {
+            std::size_t v = _n;
+            for (std::size_t u = 0; u < _n; ++u)
+                if (!removed[u] && (v == _n || degree[u] < degree[v]))
+                    v = u;
+            removed[v] = true;
+            _vertex[r] = v;
+            for (std::size_t u = 0; u < _n; ++u)
+                if (!removed[u] && (rows[v][u / 64] >> (u % 64) & 1) != 0)
+                    --degree[u];
+        }
+        std::vector<std::size_t> id(_n);
+        for (std::size_t i = 0; i < _n; ++i)
+            id[_vertex[i]] = i;
+        _adjacency.assign(_n * _words, 0);
+        for (std::size_t i = 0; i < _n; ++i)
+            for (std::size_t w = 0; w < _n; ++w)
+                if ((rows[_vertex[i]][w / 64] >> (w % 64) & 1) != 0)
+                    _adjacency[i * _words + id[w] / 64] |= std::uint64_t(1) << (id[w] % 64);
+
+        // first-fit classes in that order; a clique among 0 - i has at most _color[i] vertices
+        std::vector<std::vector<std::uint64_t>> classes;
+        _color.resize(_n);
+        for (std::size_t i = 0; i < _n; ++i) {
+            std::size_t k = 0;
+            while (k < classes.size() &&
+                   !std::equal(classes[k].begin(), classes[k].end(), _row(i),
+                               [](std::uint64_t set, std::uint64_t row) {
+                                   return (set & row) == 0;
+                               }))
+                ++k;
+            if (k == classes.size())
+                classes.emplace_back(_words, 0);
+            classes[k][i / 64] |= std::uint64_t(1) << (i % 64);
+            _color[i] = classes.size();
+        }
+    }
+
+    // Vertices of a largest clique (or the first of target vertices found), input ids
+    std::vector<std::size_t> run(unsigned num_threads) {
+        num_threads = util::thread_count(num_threads);
+        _active = num_threads;
+        util::parallel_run(num_threads, [this, num_threads](unsigned) {
+            worker search(*this, num_threads > 1);
+            task next;
+            while (_next_task(next))
+                search.solve(next);
+        });
+
+        std::vector<std::size_t> result;
+        for (std::size_t i : _best)
+            result.push_back(_vertex[i]);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    private:
+    // Clique and candidates of a subtree, and the bound its branch was taken with
+    struct task {
+        std::vector<std::size_t> clique;
+        std::vector<std::uint64_t> candidates; // words first - (first + candidates.size() - 1)
+        std::size_t first = 0, bound = 0;
+    };
+
+    // Depth of the deepest branches handed to idle threads
+    static constexpr std::size_t SPLIT_DEPTH = 2;
+
+    struct worker {
+        worker(bit_clique_search& owner, bool share) : owner(owner), share(share) {}
+
+        void solve(const task& start) {
+            if (start.bound <= owner._best_size.load(std::memory_order_relaxed) || owner._done())
+                return;
+            clique = start.clique;
+            std::size_t depth = clique.size(), last = start.first + start.candidates.size();
+            std::copy(start.candidates.begin(), start.candidates.end(),
+                      level(depth).begin() + start.first);
+            expand(depth, start.first, last);
+        }
+
+        // candidate bitset at a depth, allocated on first use
+        std::vector<std::uint64_t>& level(std::size_t depth) {
+            while (sets.size() <= depth) {
+                sets.emplace_back(owner._words, 0);
+                branches.emplace_back();
+            }
+            return sets[depth];
+        }
+
+        // only the words first - (last - 1) of the candidates at depth may be nonzero
+        void expand(std::size_t depth, std::size_t first, std::size_t last) {
+            std::vector<std::uint64_t>& candidates = sets[depth];
+            while (first < last && candidates[first] == 0)
+                ++first;
+            while (last > first && candidates[last - 1] == 0)
+                --last;
+            if (first == last) {
+                owner._offer(clique);
+                return;
+            }
+            std::size_t size = clique.size(), left = 0;
+            std::size_t best = owner._best_size.load(std::memory_order_relaxed);
+            for (std::size_t w = first; w < last; ++w)
+                left += std::popcount(candidates[w]);
+
+            // color classes of the candidates; only colors k with size + k > best are branched on,
+            // the classes 1 - low of the others are kept to renumber into
+            std::size_t span = last - first, low = best > size ? best - size : 0;
+            coloring.assign(candidates.begin() + first, candidates.begin() + last);
+            remaining.resize(span);
+            classes.assign(low * span, 0);
+            branches[depth].clear();
+            for (std::size_t k = 1; left > 0; ++k) {
+                std::copy(coloring.begin(), coloring.end(), remaining.begin());
+                for (std::size_t w = 0; w < span; ++w)
+                    while (remaining[w] != 0) {
+                        std::size_t v = (first + w) * 64 + std::countr_zero(remaining[w]);
+                        const std::uint64_t* row = owner._row(v) + first;
+                        for (std::size_t x = w; x < span; ++x)
+                            remaining[x] &= ~row[x];
+                        remaining[w] &= ~(std::uint64_t(1) << (v % 64));
+                        coloring[w] &= ~(std::uint64_t(1) << (v % 64));
+                        --left;
+                        if (k <= low)
+                            classes[(k - 1) * span + w] |= std::uint64_t(1) << (v % 64);
+                        else if (!renumber(v - first * 64, row, first, low))
+                            branches[depth].emplace_back(v, k);
+                    }
+            }
+
+            // branches[depth] is kept for this level while deeper levels use their own
+            for (std::size_t b = branches[depth].size(); b-- > 0;) {
+                std::size_t v = branches[depth][b].first, k = branches[depth][b].second;
+                if (size + k <= owner._best_size.load(std::memory_order_relaxed) || owner._done())
+                    return;
+                clique.push_back(v);
+                const std::uint64_t* row = owner._row(v);
+                if (share && b > 0 && depth <= SPLIT_DEPTH && owner._wants_task()) {
+                    task donated;
+                    donated.clique = clique;
+                    donated.candidates.resize(last - first);
+                    for (std::size_t w = first; w < last; ++w)
+                        donated.candidates[w - first] = sets[depth][w] & row[w];
+                    donated.first = first;
+                    donated.bound = size + k;
+                    owner._push_task(std::move(donated));
+                } else {
+                    std::vector<std::uint64_t>& next = level(depth + 1);
+                    for (std::size_t w = first; w < last; ++w)
+                        next[w] = sets[depth][w] & row[w];
+                    expand(depth + 1, first, last);
+                }
+                clique.pop_back();
+                sets[depth][v / 64] &= ~(std::uint64_t(1) << (v % 64));
+            }
+        }
+
+        // Move v (bit offset by first words, with its row) into a kept class: one without
+        // neighbors of v, or with a single neighbor u of v that moves on to a later kept class
+        // without neighbors of u
+        // Pablo San Segundo, Fernando Matia, Diego Rodriguez-Losada, Miguel Hernando
+        // An improved bit parallel exact maximum clique algorithm
+        // (2013) doi:10.1007/s11590-011-0431-y
+        bool renumber(std::size_t v, const std::uint64_t* row, std::size_t first, std::size_t low) {
+            std::size_t span = remaining.size();
+            for (std::size_t k = 0; k + 1 < low; ++k) {
+                std::uint64_t* set = classes.data() + k * span;
+                std::size_t count = 0, u = 0;
+                for (std::size_t x = 0; x < span && count < 2; ++x)
+                    if (std::uint64_t shared = set[x] & row[x]; shared != 0) {
+                        count += std::popcount(shared);
+                        u = x * 64 + std::countr_zero(shared);
+                    }
+                if (count > 1)
+                    continue;
+                if (count == 1) {
+                    const std::uint64_t* u_row = owner._row(first * 64 + u) + first;
+                    std::size_t to = k + 1;
+                    for (; to < low; ++to) {
+                        const std::uint64_t* target = classes.data() + to * span;
+                        std::size_t x = 0;
+                        while (x < span && (target[x] & u_row[x]) == 0)
+                            ++x;
+                        if (x == span)
+                            break;
+                    }
+                    if (to == low)
+                        continue;
+                    set[u / 64] &= ~(std::uint64_t(1) << (u % 64));
+                    classes[to * span + u / 64] |= std::uint64_t(1) << (u % 64);
+                }
+                set[v / 64] |= std::uint64_t(1) << (v % 64);
+                return true;
+            }
+            return false;
+        }
+
+        bit_clique_search& owner;
+        bool share;
+        std::vector<std::size_t> clique;
+        std::vector<std::vector<std::uint64_t>> sets;
+        std::vector<std::vector<std::pair<std::size_t, std::size_t>>> branches;
+        std::vector<std::uint64_t> coloring, remaining, classes;
+    };
+
+    const std::uint64_t* _row(std::size_t v) const { return _adjacency.data() + v * _words; }
+
+    bool _done() const { return _best_size.load(std::memory_order_relaxed) >= _target; }
+
+    // Some thread waits for work that is not queued yet
+    bool _wants_task() const {
+        return _idle.load(std::memory_order_relaxed) > _queued.load(std::memory_order_relaxed);
+    }
+
+    void _push_task(task&& donated) {
+        {
+            std::lock_guard<std::mutex> guard(_queue_lock);
+            _tasks.push_back(std::move(donated));
+            _queued.store(_tasks.size(), std::memory_order_relaxed);
+        }
+        _wake.notify_one();
+    }
+
+    // Claim the next root branch, or else a queued subtree; false once every thread is out of
+    // work
+    bool _next_task(task& next) {
+        for (std::size_t t = _next_root.fetch_add(1); t < _n; t = _next_root.fetch_add(1)) {
+            // branch on i, with the vertices after it in branching order already excluded
+            std::size_t i = _n - 1 - t;
+            if (_color[i] <= _best_size.load(std::memory_order_relaxed) || _done())
+                continue;
+            next.clique.assign(1, i);
+            next.candidates.assign(_row(i), _row(i) + i / 64 + 1);
+            next.candidates[i / 64] &= (std::uint64_t(1) << (i % 64)) - 1;
+            next.first = 0;
+            next.bound = _color[i];
+            return true;
+        }
+
+        std::unique_lock<std::mutex> guard(_queue_lock);
+        --_active;
+        _idle.fetch_add(1, std::memory_order_relaxed);
+        _wake.wait(guard, [this]() { return !_tasks.empty() || _active == 0; });
+        _idle.fetch_sub(1, std::memory_order_relaxed);
+        if (_tasks.empty()) {
+            _wake.notify_all();
+            return false;
+        }
+        next = std::move(_tasks.back());
+        _tasks.pop_back();
+        _queued.store(_tasks.size(), std::memory_order_relaxed);
+        ++_active;
+        return true;
+    }
+
+    void _offer(const std::vector<std::size_t>& clique) {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (clique.size() > _best.size()) {
+            _best = clique;
+            _best_size.store(clique.size(), std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t _n, _words, _target;
+    std::vector<std::size_t> _vertex, _color; // input id and color of every renumbered vertex
+    std::vector<std::uint64_t> _adjacency;    // _words words per vertex
+
+    std::atomic<std::size_t> _best_size;
+    std::vector<std::size_t> _best;
+    std::mutex _lock;
+
+    std::atomic<std::size_t> _next_root; // root branches are claimed in branching order
+    std::size_t _active;                 // threads not waiting for a task, guarded by _queue_lock
+    std::atomic<std::size_t> _idle, _queued;
+    std::vector<task> _tasks;
+    std::mutex _queue_lock;
+    std::condition_variable _wake;
+};
+
+/*
+ * Maximum clique of an undirected graph in CSR form, in increasing order of ids
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> maximum_clique(const util::csr_graph<EdgeWeight>& input,
+                                        unsigned num_threads = 1) {
+    return bit_clique_search(input, false, input.order()).run(num_threads);
+}
+
+/*
+ * Maximum independent set of an undirected graph in CSR form: a maximum clique of the complement,
+ * whose bitsets are complemented directly
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> maximum_independent_set(const util::csr_graph<EdgeWeight>& input,
+                                                 unsigned num_threads = 1) {
+    return bit_clique_search(input, true, input.order()).run(num_threads);
+}
+
+/*
+ * Solve a Clique instance (see certificate.h): a certificate if one exists, an empty list otherwise
+ * The search stops at the first clique of the required size
+ */
+template<typename T, bool Weighted, typename... Args>
+std::list<T> Clique_solver(
+  const std::pair<graph::graph<T, false, Weighted, Args...>, std::size_t>& instance,
+  unsigned num_threads = 1) {
+    std::vector<T> vertices = instance.first.vertices();
+    std::vector<std::size_t> found =
+      bit_clique_search(util::get_csr_rep(instance.first), false, instance.second)
+        .run(num_threads);
+    std::list<T> result;
+    if (found.size() >= instance.second)
+        for (std::size_t v : found)
+            result.push_back(vertices[v]);
+    return result;
+}
+
+/*
+ * Solve an Independent Set instance, such as those of Clique_to_Independent_Set: a certificate if
+ * one exists, an empty list otherwise
+ */
+template<typename T, bool Weighted, typename... Args>
+std::list<T> Independent_Set_solver(
+  const std::pair<graph::graph<T, false, Weighted, Args...>, std::size_t>& instance,
+  unsigned num_threads = 1) {
+    std::vector<T> vertices = instance.first.vertices();
+    std::vector<std::size_t> found =
+      bit_clique_search(util::get_csr_rep(instance.first), true, instance.second)
+        .run(num_threads);
+    std::list<T> result;
+    if (found.size() >= instance.second)
+        for (std::size_t v : found)
+            result.push_back(vertices[v]);
+    return result;
+}
+} // namespace NP_complete
+
+#endif // NPC_CLIQUE_H
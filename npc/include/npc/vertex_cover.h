@@ -0,0 +1,438 @@
+#ifndef NPC_VERTEX_COVER_H
+#define NPC_VERTEX_COVER_H
+
+#include <algorithm>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include <graph/bipartite.h>
+
+#include <structures/graph.h>
+
+#include <util/exposed_graph.h>
+#include <util/parallel.h>
+
+namespace NP_complete {
+/*
+ * Kernel of a vertex cover instance: the rules below are applied until none does, leaving a graph
+ * of minimum degree 3 whose LP relaxation is all 1/2
+ *
+ * Degree 0: the vertex is not in the cover
+ * Degree 1: its neighbor is
+ * Degree 2 with adjacent neighbors: both neighbors are
+ * Degree 2 with neighbors u, w not adjacent: v, u, w fold into one vertex x adjacent to N(u) and
+ *   N(w), and the cover grows by one; x is later replaced by u and w if in the cover, by v if not
+ * LP: a half-integral optimum of the LP relaxation, from a maximum matching of the bipartite
+ *   double cover and König's theorem; vertices at 1 are in the cover, those at 0 are not. Every
+ *   crown (an independent set matched into its neighborhood) is removed this way
+ *
+ * Jianer Chen, Iyad Kanj, Weijia Jia
+ * Vertex cover: further observations and further improvements
+ * (2001) doi:10.1006/jagm.2001.1186
+ * George Nemhauser, Leslie Trotter
+ * Vertex packings: structural properties and algorithms
+ * (1975) doi:10.1007/BF01580444
+ * Faisal Abu-Khzam, Rebecca Collins, Michael Fellows, Michael Langston, Henry Suters,
+ * Christopher Symons
+ * Kernelization algorithms for the vertex cover problem: theory and experiments
+ * (2004) ALENEX
+ * O(E sqrt(V)) per LP round, the other rules O(V+E) overall but for folds
+ */
+class vertex_cover_kernel {
+    public:
+    // Kernel of an undirected graph in CSR form; self-loops put their vertex in the cover
+    template<typename EdgeWeight>
+    explicit vertex_cover_kernel(const util::csr_graph<EdgeWeight>& input,
+                                 unsigned num_threads = 1) :
+        _n(input.order()),
+        _adjacency(_n),
+        _degree(_n, 0),
+        _status(_n, status::live),
+        _mark(_n, NONE),
+        _taken(0),
+        _threads(num_threads) {
+        std::vector<std::size_t> looped;
+        for (std::size_t v = 0; v < _n; ++v) {
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                if (input.targets[j] != v)
+                    _adjacency[v].push_back(input.targets[j]);
+                else if (looped.empty() || looped.back() != v)
+                    looped.push_back(v);
+            std::sort(_adjacency[v].begin(), _adjacency[v].end());
+            _adjacency[v].erase(std::unique(_adjacency[v].begin(), _adjacency[v].end()),
+                                _adjacency[v].end());
+            _degree[v] = _adjacency[v].size();
+            if (_degree[v] <= 2)
+                _pending.push_back(v);
+        }
+        for (std::size_t v : looped)
+            _take(v);
+
+        do
+            _reduce();
+        while (_linear_program());
+    }
+
+    // Cover vertices decided so far, counting one per fold
+    std::size_t cover_size() const noexcept { return _taken; }
+
+    // Ids of the kernel vertices, which include the folded ones past the input order
+    std::size_t size() const noexcept { return _status.size(); }
+
+    bool is_live(std::size_t v) const { return _status[v] == status::live; }
+
+    // Neighbors of a kernel vertex, some of which may be gone: check with is_live
+    const std::vector<std::size_t>& neighbors(std::size_t v) const { return _adjacency[v]; }
+
+    std::vector<std::size_t> live() const {
+        std::vector<std::size_t> result;
+        for (std::size_t v = 0; v < size(); ++v)
+            if (is_live(v))
+                result.push_back(v);
+        return result;
+    }
+
+    // Cover of the input, in increasing order, from a cover of the kernel
+    std::vector<std::size_t> unfold(const std::vector<std::size_t>& chosen) const {
+        std::vector<bool> in_cover(size(), false);
+        for (std::size_t v = 0; v < size(); ++v)
+            in_cover[v] = _status[v] == status::cover;
+        for (std::size_t v : chosen)
+            in_cover[v] = true;
+        for (auto it = _folds.rbegin(); it != _folds.rend(); ++it) {
+            in_cover[it->v] = !in_cover[it->x];
+            in_cover[it->u] = in_cover[it->w] = in_cover[it->x];
+        }
+        std::vector<std::size_t> result;
+        for (std::size_t v = 0; v < _n; ++v)
+            if (in_cover[v])
+                result.push_back(v);
+        return result;
+    }
+
+    private:
+    static constexpr std::size_t NONE = -1;
+    enum class status : char { live, cover, excluded, folded };
+    struct fold {
+        std::size_t v, u, w, x;
+    };
+
+    void _take(std::size_t v) {
+        _status[v] = status::cover;
+        ++_taken;
+        for (std::size_t w : _adjacency[v])
+            if (is_live(w) && --_degree[w] <= 2)
+                _pending.push_back(w);
+    }
+
+    bool _adjacent(std::size_t u, std::size_t w) const {
+        if (_adjacency[u].size() > _adjacency[w].size())
+            std::swap(u, w);
+        return std::find(_adjacency[u].begin(), _adjacency[u].end(), w) != _adjacency[u].end();
+    }
+
+    void _fold(std::size_t v, std::size_t u, std::size_t w) {
+        std::size_t x = size();
+        std::vector<std::size_t> merged;
+        for (std::size_t y : _adjacency[u])
+            if (is_live(y) && y != v) {
+                _mark[y] = x;
+                merged.push_back(y);
+            }
+        for (std::size_t y : _adjacency[w])
+            if (is_live(y) && y != v) {
+                if (_mark[y] == x)
+                    --_degree[y]; // loses both u and w
+                else
+                    merged.push_back(y);
+            }
+
+        _status[v] = _status[u] = _status[w] = status::folded;
+        _folds.push_back({v, u, w, x});
+        ++_taken;
+        for (std::size_t y : merged) {
+            _adjacency[y].push_back(x);
+            if (_degree[y] <= 2)
+                _pending.push_back(y);
+        }
+        _degree.push_back(merged.size());
+        _status.push_back(status::live);
+        _mark.push_back(NONE);
+        _adjacency.push_back(std::move(merged));
+        if (_degree[x] <= 2)
+            _pending.push_back(x);
+    }
+
+    void _reduce() {
+        while (!_pending.empty()) {
+            std::size_t v = _pending.back();
+            _pending.pop_back();
+            if (!is_live(v) || _degree[v] > 2)
+                continue;
+            std::size_t ends[2], found = 0;
+            for (std::size_t w : _adjacency[v])
+                if (is_live(w))
+                    ends[found++] = w;
+            if (found == 0) {
+                _status[v] = status::excluded;
+            } else if (found == 1) {
+                _take(ends[0]);
+            } else if (_adjacent(ends[0], ends[1])) {
+                _take(ends[0]);
+                _take(ends[1]);
+            } else {
+                _fold(v, ends[0], ends[1]);
+            }
+        }
+    }
+
+    // One LP round; false if every live vertex is at 1/2
+    bool _linear_program() {
+        std::vector<std::size_t> vertices = live(), id(size(), NONE);
+        std::size_t k = vertices.size();
+        for (std::size_t i = 0; i < k; ++i)
+            id[vertices[i]] = i;
+        std::vector<std::size_t> offsets(1, 0), targets;
+        for (std::size_t v : vertices) {
+            for (std::size_t w : _adjacency[v])
+                if (is_live(w))
+                    targets.push_back(id[w]);
+            offsets.push_back(targets.size());
+        }
+
+        // König: left copies reached by alternating paths from free left copies are out of the
+        // minimum cover of the double cover, right copies reached are in
+        std::vector<std::size_t> match_left = graph_alg::Hopcroft_Karp(k, offsets, targets,
+                                                                       _threads);
+        std::vector<std::size_t> match_right(k, k), stack;
+        std::vector<bool> left_reached(k, false), right_reached(k, false);
+        for (std::size_t u = 0; u < k; ++u) {
+            if (match_left[u] != k)
+                match_right[match_left[u]] = u;
+            else {
+                left_reached[u] = true;
+                stack.push_back(u);
+            }
+        }
+        while (!stack.empty()) {
+            std::size_t u = stack.back();
+            stack.pop_back();
+            for (std::size_t j = offsets[u]; j < offsets[u + 1]; ++j) {
+                std::size_t r = targets[j];
+                if (right_reached[r])
+                    continue;
+                right_reached[r] = true;
+                if (match_right[r] != k && !left_reached[match_right[r]]) {
+                    left_reached[match_right[r]] = true;
+                    stack.push_back(match_right[r]);
+                }
+            }
+        }
+
+        bool changed = false;
+        for (std::size_t i = 0; i < k; ++i)
+            if (!left_reached[i] && right_reached[i]) {
+                _take(vertices[i]);
+                changed = true;
+            }
+        // the neighbors of vertices at 0 are all at 1
+        for (std::size_t i = 0; i < k; ++i)
+            if (left_reached[i] && !right_reached[i]) {
+                _status[vertices[i]] = status::excluded;
+                changed = true;
+            }
+        return changed;
+    }
+
+    std::size_t _n;
+    std::vector<std::vector<std::size_t>> _adjacency;
+    std::vector<std::size_t> _degree;
+    std::vector<status> _status;
+    std::vector<std::size_t> _mark, _pending;
+    std::vector<fold> _folds;
+    std::size_t _taken;
+    unsigned _threads;
+};
+
+template<typename EdgeWeight>
+static std::vector<std::size_t> vertex_cover_search(const util::csr_graph<EdgeWeight>& input,
+                                                    std::size_t limit, unsigned num_threads,
+                                                    bool& found);
+
+// Subgraph induced by the vertices not dropped, with the input id of each of its vertices
+template<typename EdgeWeight>
+static util::csr_graph<std::size_t> vertex_cover_induced(const util::csr_graph<EdgeWeight>& input,
+                                                         const std::vector<bool>& dropped,
+                                                         std::vector<std::size_t>& ids) {
+    const std::size_t NONE = -1;
+    std::vector<std::size_t> local(input.order(), NONE);
+    ids.clear();
+    for (std::size_t v = 0; v < input.order(); ++v)
+        if (!dropped[v]) {
+            local[v] = ids.size();
+            ids.push_back(v);
+        }
+    util::csr_graph<std::size_t> result;
+    result.offsets.push_back(0);
+    for (std::size_t v : ids) {
+        for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+            if (!dropped[input.targets[j]])
+                result.targets.push_back(local[input.targets[j]]);
+        result.offsets.push_back(result.targets.size());
+    }
+    return result;
+}
+
+// Minimum cover of a connected kernel within limit: a vertex v of maximum degree is in the cover,
+// or else all its neighbors are. With more than one thread both branches run at once, splitting
+// the threads; otherwise the second only looks for covers smaller than the first found
+template<typename EdgeWeight>
+static std::vector<std::size_t> vertex_cover_branch(const util::csr_graph<EdgeWeight>& input,
+                                                    std::size_t limit, unsigned num_threads,
+                                                    bool& found) {
+    std::size_t n = input.order(), v = 0;
+    for (std::size_t u = 1; u < n; ++u)
+        if (input.degree(u) > input.degree(v))
+            v = u;
+
+    std::vector<std::size_t> covers[2];
+    bool covered[2] = {false, false};
+    auto branch = [&](unsigned side, unsigned threads, std::size_t bound) {
+        std::size_t taken = side == 0 ? 1 : input.degree(v);
+        if (taken > bound)
+            return;
+        std::vector<bool> dropped(n, false);
+        dropped[v] = true;
+        if (side == 1)
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                dropped[input.targets[j]] = true;
+        std::vector<std::size_t> ids;
+        util::csr_graph<std::size_t> rest = vertex_cover_induced(input, dropped, ids);
+        std::vector<std::size_t> cover =
+          vertex_cover_search(rest, bound - taken, threads, covered[side]);
+        if (!covered[side])
+            return;
+        for (std::size_t w : cover)
+            covers[side].push_back(ids[w]);
+        if (side == 0)
+            covers[side].push_back(v);
+        else
+            covers[side].insert(covers[side].end(), input.targets.begin() + input.offsets[v],
+                                input.targets.begin() + input.offsets[v + 1]);
+    };
+
+    unsigned threads = util::thread_count(num_threads);
+    if (threads > 1) {
+        util::parallel_run(2, [&branch, threads, limit](unsigned id) {
+            branch(id, id == 0 ? threads / 2 : threads - threads / 2, limit);
+        });
+    } else {
+        branch(0, 1, limit);
+        branch(1, 1, covered[0] ? covers[0].size() - 1 : limit);
+    }
+
+    found = covered[0] || covered[1];
+    if (covered[1] && (!covered[0] || covers[1].size() < covers[0].size()))
+        return covers[1];
+    return covers[0];
+}
+
+/*
+ * Minimum vertex cover of size at most limit, as input ids; found is false (and the result empty)
+ * if there is none
+ * Branch and reduce: the input is kernelized, the kernel split into connected components, and
+ * each component branched on, every branch kernelized again. A component gets the budget left by
+ * the lower bounds (half their order, from the LP) of the others; num_threads threads (0: all
+ * hardware threads) are split between the branches at the top of the search tree
+ *
+ * Takuya Akiba, Yoichi Iwata
+ * Branch-and-reduce exponential/FPT algorithms in practice: a case study of vertex cover
+ * (2016) doi:10.1016/j.tcs.2015.09.023
+ * O(2^(k - LP) poly(V)) for a cover of size k above the LP bound
+ */
+template<typename EdgeWeight>
+static std::vector<std::size_t> vertex_cover_search(const util::csr_graph<EdgeWeight>& input,
+                                                    std::size_t limit, unsigned num_threads,
+                                                    bool& found) {
+    const std::size_t NONE = -1;
+    vertex_cover_kernel kernel(input, num_threads);
+
+    std::vector<std::size_t> component_of(kernel.size(), NONE);
+    std::vector<std::vector<std::size_t>> members;
+    std::size_t lower = kernel.cover_size();
+    for (std::size_t s : kernel.live()) {
+        if (component_of[s] != NONE)
+            continue;
+        component_of[s] = members.size();
+        members.emplace_back(1, s);
+        for (std::size_t i = 0; i < members.back().size(); ++i)
+            for (std::size_t w : kernel.neighbors(members.back()[i]))
+                if (kernel.is_live(w) && component_of[w] == NONE) {
+                    component_of[w] = component_of[s];
+                    members.back().push_back(w);
+                }
+        lower += (members.back().size() + 1) / 2;
+    }
+    found = lower <= limit;
+    if (!found)
+        return std::vector<std::size_t>();
+
+    // each component on local ids
+    std::size_t slack = limit - lower;
+    std::vector<std::size_t> chosen, local(kernel.size(), NONE);
+    for (const std::vector<std::size_t>& ids : members) {
+        for (std::size_t i = 0; i < ids.size(); ++i)
+            local[ids[i]] = i;
+        util::csr_graph<std::size_t> component;
+        component.offsets.push_back(0);
+        for (std::size_t v : ids) {
+            for (std::size_t w : kernel.neighbors(v))
+                if (kernel.is_live(w))
+                    component.targets.push_back(local[w]);
+            component.offsets.push_back(component.targets.size());
+        }
+
+        std::size_t half = (ids.size() + 1) / 2;
+        std::vector<std::size_t> cover =
+          vertex_cover_branch(component, half + slack, num_threads, found);
+        if (!found)
+            return std::vector<std::size_t>();
+        slack -= cover.size() - half;
+        for (std::size_t v : cover)
+            chosen.push_back(ids[v]);
+    }
+    return kernel.unfold(chosen);
+}
+
+/*
+ * Minimum vertex cover of an undirected graph in CSR form, in increasing order of ids
+ */
+template<typename EdgeWeight>
+std::vector<std::size_t> minimum_vertex_cover(const util::csr_graph<EdgeWeight>& input,
+                                              unsigned num_threads = 1) {
+    bool found;
+    return vertex_cover_search(input, input.order(), num_threads, found);
+}
+
+/*
+ * Solve a Vertex Cover instance (see certificate.h): a minimum cover if it has at most k
+ * vertices, an empty list otherwise
+ * k bounds the search: kernels whose LP bound exceeds it are rejected without branching
+ */
+template<typename T, bool Weighted, typename... Args>
+std::list<T> Vertex_Cover_solver(
+  const std::pair<graph::graph<T, false, Weighted, Args...>, std::size_t>& instance,
+  unsigned num_threads = 1) {
+    std::vector<T> vertices = instance.first.vertices();
+    bool found;
+    std::vector<std::size_t> cover = vertex_cover_search(
+      util::get_csr_rep(instance.first), instance.second, num_threads, found);
+    std::list<T> result;
+    for (std::size_t v : cover)
+        result.push_back(vertices[v]);
+    return result;
+}
+} // namespace NP_complete
+
+#endif // NPC_VERTEX_COVER_H
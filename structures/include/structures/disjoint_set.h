@@ -2,9 +2,12 @@
 #define UNION_FIND_H
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 /**
  * Also known as UNION-FIND
@@ -56,6 +59,84 @@ class disjoint_set {
     std::unordered_set<T, Hash, KeyEqual> _roots;
 };
 
+/**
+ * UNION-FIND on the dense ids 0 - (size() - 1), stored in two flat arrays
+ * Union by size, path halving
+ *
+ * Robert Tarjan, Jan van Leeuwen
+ * Worst-case analysis of set union algorithms
+ * (1984) doi:10.1145/62.2160
+ */
+template<typename Index = std::size_t> class dense_disjoint_set {
+    public:
+    static_assert(std::is_integral_v<Index> && std::is_unsigned_v<Index>,
+                  "Ids must be an unsigned integer type");
+
+    // Start with the singletons 0 - (n - 1)
+    explicit dense_disjoint_set(Index n = 0);
+
+    // Add a new singleton, returns its id
+    // O(1) amortized
+    Index insert();
+
+    // Union the sets that the parameter elements belong to; returns false if already joined
+    // O(α(n)) amortized
+    bool union_sets(Index first, Index second);
+
+    // Return the root of the set/tree, halving the path to it
+    // O(α(n)) amortized
+    Index find(Index item);
+
+    // Return the root of the set/tree without modifying the structure
+    // Safe to call concurrently as long as nothing is modified
+    // O(log n)
+    Index root(Index item) const;
+
+    // Number of elements in the set containing the parameter
+    Index set_size(Index item);
+
+    std::size_t size() const noexcept;
+    std::size_t num_sets() const noexcept;
+
+    private:
+    std::vector<Index> _parent;
+    std::vector<Index> _size;
+    std::size_t _num_sets;
+};
+
+/**
+ * Lock-free UNION-FIND on the dense ids 0 - (size() - 1)
+ * All operations may be called concurrently; roots are linked by compare-and-swap (the lower id
+ * under the higher), and find() halves paths with compare-and-swap
+ *
+ * Richard Anderson, Heather Woll
+ * Wait-free parallel algorithms for the union-find problem
+ * (1991) doi:10.1145/103418.103458
+ */
+template<typename Index = std::size_t> class concurrent_disjoint_set {
+    public:
+    static_assert(std::is_integral_v<Index> && std::is_unsigned_v<Index>,
+                  "Ids must be an unsigned integer type");
+
+    // Start with the singletons 0 - (n - 1)
+    explicit concurrent_disjoint_set(Index n = 0);
+
+    // Union the sets that the parameter elements belong to; returns false if already joined
+    // Of several concurrent calls joining the same two sets, exactly one returns true
+    bool union_sets(Index first, Index second);
+
+    // Return the current root of the set/tree
+    Index find(Index item);
+
+    // Whether the parameter elements are in the same set
+    bool same_set(Index first, Index second);
+
+    std::size_t size() const noexcept;
+
+    private:
+    std::vector<std::atomic<Index>> _parent;
+};
+
 #include "../../src/structures/disjoint_set.tpp"
 
 #endif // UNION_FIND_H
@@ -0,0 +1,80 @@
+#ifndef LINK_CUT_TREE_H
+#define LINK_CUT_TREE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * A forest of unrooted trees on nodes 0 - (size() - 1) supporting edge insertion and removal,
+ * connectivity, and path maximum queries
+ * Every node holds a value; path_max returns the node with the greatest value on a tree path
+ *
+ * Daniel Sleator, Robert Tarjan
+ * A data structure for dynamic trees
+ * (1983) doi:10.1016/0022-0000(83)90006-5
+ *
+ * Splay-tree representation of preferred paths:
+ * Daniel Sleator, Robert Tarjan
+ * Self-adjusting binary search trees
+ * (1985) doi:10.1145/3828.3835
+ */
+template<typename T, typename Compare = std::less<T>> class link_cut_tree {
+    public:
+    explicit link_cut_tree(Compare compare = Compare());
+
+    // Adds an isolated node with the given value, returns its id
+    // O(1)
+    std::size_t add_node(const T& value);
+
+    // Adds the edge u-v; throws std::invalid_argument if u and v are already connected
+    // O(log n) amortized
+    void link(std::size_t u, std::size_t v);
+
+    // Removes the edge u-v; throws std::invalid_argument if there is no such edge
+    // O(log n) amortized
+    void cut(std::size_t u, std::size_t v);
+
+    // O(log n) amortized
+    bool connected(std::size_t u, std::size_t v);
+
+    // Node of greatest value on the path between u and v (which must be connected)
+    // O(log n) amortized
+    std::size_t path_max(std::size_t u, std::size_t v);
+
+    const T& value(std::size_t v) const;
+
+    // O(log n) amortized
+    void set_value(std::size_t v, const T& value);
+
+    std::size_t size() const noexcept;
+
+    private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    struct node {
+        std::size_t child[2];
+        std::size_t parent; // splay parent, or path-parent if this is a splay root
+        std::size_t max;    // node of greatest value in this splay subtree
+        bool reversed;
+        T value;
+    };
+
+    bool _is_splay_root(std::size_t x) const;
+    void _push(std::size_t x);
+    void _pull(std::size_t x);
+    void _rotate(std::size_t x);
+    void _splay(std::size_t x);
+    void _access(std::size_t x);
+    void _make_root(std::size_t x);
+    std::size_t _find_root(std::size_t x);
+    void _check(std::size_t x) const;
+
+    std::vector<node> _nodes;
+    std::vector<std::size_t> _stack;
+    Compare _compare;
+};
+
+#include "../../src/structures/link_cut_tree.tpp"
+
+#endif // LINK_CUT_TREE_H
@@ -0,0 +1,99 @@
+#ifndef PARTITION_REFINEMENT_H
+#define PARTITION_REFINEMENT_H
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * An ordered partition of the dense ids 0 - (n - 1) into classes, refined by splitting every
+ * class against a pivot set
+ * Elements and classes are doubly linked through flat arrays, so a split keeps the relative order
+ * of the elements on both sides, and costs time proportional to the pivot set only
+ *
+ * Placement of the part of a class that lies in a pivot set:
+ * in_place: right before the rest of its class (LexBFS)
+ * to_front: at the front of the whole sequence, in the order of the classes it came from (LexDFS)
+ *
+ * Michel Habib, Ross McConnell, Christophe Paul, Laurent Viennot
+ * Lex-BFS and partition refinement, with applications to transitive orientation, interval graph
+ * recognition and consecutive ones testing
+ * (2000) doi:10.1016/S0304-3975(97)00241-7
+ */
+template<typename Index = std::size_t> class partition_refinement {
+    public:
+    static_assert(std::is_integral_v<Index> && std::is_unsigned_v<Index>,
+                  "Ids must be an unsigned integer type");
+
+    enum class placement { in_place, to_front };
+
+    static constexpr Index NONE = static_cast<Index>(-1);
+
+    // One class holding 0 - (n - 1) in increasing order
+    explicit partition_refinement(Index n = 0, placement where = placement::in_place);
+
+    // One class holding a permutation of 0 - (order.size() - 1), in the given order
+    explicit partition_refinement(const std::vector<Index>& order,
+                                  placement where = placement::in_place);
+
+    // Split every class against the elements of [first, last), which move to a new class
+    // Removed elements are ignored; the moved elements keep the order of the range
+    // O(last - first), plus O(k log k) to order k split classes with to_front
+    template<typename InputIt> void refine(InputIt first, InputIt last);
+
+    // As above, calling on_split(set, part) once the refinement is done for every class set that
+    // kept some of its elements, with part the new class of the moved ones
+    template<typename InputIt, typename SplitFunction>
+    void refine(InputIt first, InputIt last, SplitFunction on_split);
+
+    // Take an element out of the partition
+    // O(1)
+    void remove(Index item);
+
+    bool contains(Index item) const noexcept;
+
+    // First element of the first class, NONE if empty
+    Index front() const noexcept;
+
+    // Classes in order, and the elements of each in order: NONE past the end
+    Index first_class() const noexcept;
+    Index next_class(Index set) const;
+    Index first_element(Index set) const;
+    Index next_element(Index item) const;
+
+    // Class containing item, NONE if removed
+    // Ids of classes are reused once they become empty
+    Index class_of(Index item) const;
+    Index class_size(Index set) const;
+
+    // Number of elements not removed
+    std::size_t size() const noexcept;
+    std::size_t num_classes() const noexcept;
+
+    private:
+    static std::vector<Index> _identity(Index n);
+    void _append(Index set, Index item);
+    void _unlink(Index item);
+    Index _new_class();
+    void _free_class(Index set);
+    void _insert_class(Index set, Index before);
+    void _unlink_class(Index set);
+    void _check(Index item) const;
+
+    placement _where;
+
+    // element lists
+    std::vector<Index> _next, _prev, _class;
+
+    // class lists
+    std::vector<Index> _head, _tail, _size, _next_class, _prev_class, _split;
+    std::vector<std::int64_t> _key; // increasing along the class list (to_front only)
+    std::vector<Index> _free, _touched;
+    Index _first_class, _last_class;
+    std::int64_t _front_key;
+    std::size_t _num_elements, _num_classes;
+};
+
+#include "../../src/structures/partition_refinement.tpp"
+
+#endif // PARTITION_REFINEMENT_H
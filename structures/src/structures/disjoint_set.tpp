@@ -82,4 +82,116 @@ uint32_t disjoint_set<T, Hash, KeyEqual>::num_sets() const noexcept {
     return _roots.size();
 }
 
+template<typename Index>
+dense_disjoint_set<Index>::dense_disjoint_set(Index n) : _parent(n), _size(n, 1), _num_sets(n) {
+    for (Index i = 0; i < n; ++i)
+        _parent[i] = i;
+}
+
+template<typename Index> Index dense_disjoint_set<Index>::insert() {
+    Index id = static_cast<Index>(_parent.size());
+    _parent.push_back(id);
+    _size.push_back(1);
+    ++_num_sets;
+    return id;
+}
+
+template<typename Index> bool dense_disjoint_set<Index>::union_sets(Index first, Index second) {
+    first = find(first);
+    second = find(second);
+    if (first == second)
+        return false;
+
+    if (_size[first] < _size[second])
+        std::swap(first, second);
+    _parent[second] = first;
+    _size[first] += _size[second];
+    --_num_sets;
+    return true;
+}
+
+template<typename Index> Index dense_disjoint_set<Index>::find(Index item) {
+    if (item >= _parent.size())
+        throw std::out_of_range("No such element");
+    while (_parent[item] != item) {
+        _parent[item] = _parent[_parent[item]];
+        item = _parent[item];
+    }
+    return item;
+}
+
+template<typename Index> Index dense_disjoint_set<Index>::root(Index item) const {
+    while (_parent[item] != item)
+        item = _parent[item];
+    return item;
+}
+
+template<typename Index> Index dense_disjoint_set<Index>::set_size(Index item) {
+    return _size[find(item)];
+}
+
+template<typename Index> std::size_t dense_disjoint_set<Index>::size() const noexcept {
+    return _parent.size();
+}
+
+template<typename Index> std::size_t dense_disjoint_set<Index>::num_sets() const noexcept {
+    return _num_sets;
+}
+
+template<typename Index>
+concurrent_disjoint_set<Index>::concurrent_disjoint_set(Index n) : _parent(n) {
+    for (Index i = 0; i < n; ++i)
+        _parent[i].store(i, std::memory_order_relaxed);
+}
+
+template<typename Index>
+bool concurrent_disjoint_set<Index>::union_sets(Index first, Index second) {
+    while (true) {
+        first = find(first);
+        second = find(second);
+        if (first == second)
+            return false;
+
+        // fixed linking order prevents cycles between concurrent links
+        if (first > second)
+            std::swap(first, second);
+        Index expected = first;
+        if (_parent[first].compare_exchange_strong(expected, second, std::memory_order_acq_rel))
+            return true;
+        // first stopped being a root in the meantime: retry from the new roots
+    }
+}
+
+template<typename Index> Index concurrent_disjoint_set<Index>::find(Index item) {
+    if (item >= _parent.size())
+        throw std::out_of_range("No such element");
+
+    Index parent = _parent[item].load(std::memory_order_acquire);
+    while (parent != item) {
+        Index grandparent = _parent[parent].load(std::memory_order_acquire);
+        // path halving; losing the race only means another thread already shortened the path
+        _parent[item].compare_exchange_weak(parent, grandparent, std::memory_order_acq_rel);
+        item = grandparent;
+        parent = _parent[item].load(std::memory_order_acquire);
+    }
+    return item;
+}
+
+template<typename Index>
+bool concurrent_disjoint_set<Index>::same_set(Index first, Index second) {
+    while (true) {
+        first = find(first);
+        second = find(second);
+        if (first == second)
+            return true;
+        // distinct roots are only conclusive if first is still a root
+        if (_parent[first].load(std::memory_order_acquire) == first)
+            return false;
+    }
+}
+
+template<typename Index> std::size_t concurrent_disjoint_set<Index>::size() const noexcept {
+    return _parent.size();
+}
+
 #endif // !UNION_FIND_CPP
@@ -0,0 +1,190 @@
+#ifndef LINK_CUT_TREE_TPP
+#define LINK_CUT_TREE_TPP
+
+#include <stdexcept>
+#include <utility>
+
+template<typename T, typename Compare>
+link_cut_tree<T, Compare>::link_cut_tree(Compare compare) : _nodes(), _stack(), _compare(compare) {}
+
+template<typename T, typename Compare>
+std::size_t link_cut_tree<T, Compare>::add_node(const T& value) {
+    std::size_t id = _nodes.size();
+    _nodes.push_back(node{{NONE, NONE}, NONE, id, false, value});
+    return id;
+}
+
+template<typename T, typename Compare>
+void link_cut_tree<T, Compare>::link(std::size_t u, std::size_t v) {
+    _check(u);
+    _check(v);
+    _make_root(u);
+    if (_find_root(v) == u)
+        throw std::invalid_argument("Nodes are already connected");
+    _nodes[u].parent = v;
+}
+
+template<typename T, typename Compare>
+void link_cut_tree<T, Compare>::cut(std::size_t u, std::size_t v) {
+    _check(u);
+    _check(v);
+    _make_root(u);
+    _access(v);
+    _splay(v);
+    // u-v is an edge exactly when u is alone to the left of v on the root path
+    std::size_t left = _nodes[v].child[0];
+    if (left != u)
+        throw std::invalid_argument("No such edge");
+    _push(u);
+    if (_nodes[u].child[1] != NONE)
+        throw std::invalid_argument("No such edge");
+
+    _nodes[v].child[0] = NONE;
+    _nodes[u].parent = NONE;
+    _pull(v);
+}
+
+template<typename T, typename Compare>
+bool link_cut_tree<T, Compare>::connected(std::size_t u, std::size_t v) {
+    _check(u);
+    _check(v);
+    return u == v || _find_root(u) == _find_root(v);
+}
+
+template<typename T, typename Compare>
+std::size_t link_cut_tree<T, Compare>::path_max(std::size_t u, std::size_t v) {
+    if (!connected(u, v))
+        throw std::invalid_argument("Nodes are not connected");
+    _make_root(u);
+    _access(v);
+    _splay(v);
+    return _nodes[v].max;
+}
+
+template<typename T, typename Compare>
+const T& link_cut_tree<T, Compare>::value(std::size_t v) const {
+    _check(v);
+    return _nodes[v].value;
+}
+
+template<typename T, typename Compare>
+void link_cut_tree<T, Compare>::set_value(std::size_t v, const T& value) {
+    _check(v);
+    _access(v);
+    _splay(v);
+    _nodes[v].value = value;
+    _pull(v);
+}
+
+template<typename T, typename Compare>
+std::size_t link_cut_tree<T, Compare>::size() const noexcept {
+    return _nodes.size();
+}
+
+template<typename T, typename Compare>
+bool link_cut_tree<T, Compare>::_is_splay_root(std::size_t x) const {
+    std::size_t p = _nodes[x].parent;
+    return p == NONE || (_nodes[p].child[0] != x && _nodes[p].child[1] != x);
+}
+
+template<typename T, typename Compare> void link_cut_tree<T, Compare>::_push(std::size_t x) {
+    node& current = _nodes[x];
+    if (!current.reversed)
+        return;
+    std::swap(current.child[0], current.child[1]);
+    for (std::size_t c : current.child)
+        if (c != NONE)
+            _nodes[c].reversed = !_nodes[c].reversed;
+    current.reversed = false;
+}
+
+template<typename T, typename Compare> void link_cut_tree<T, Compare>::_pull(std::size_t x) {
+    node& current = _nodes[x];
+    current.max = x;
+    for (std::size_t c : current.child)
+        if (c != NONE && _compare(_nodes[current.max].value, _nodes[_nodes[c].max].value))
+            current.max = _nodes[c].max;
+}
+
+template<typename T, typename Compare> void link_cut_tree<T, Compare>::_rotate(std::size_t x) {
+    std::size_t p = _nodes[x].parent;
+    std::size_t g = _nodes[p].parent;
+    bool side = _nodes[p].child[1] == x;
+
+    // x takes p's place, including p's path-parent pointer if p was a splay root
+    if (!_is_splay_root(p))
+        _nodes[g].child[_nodes[g].child[1] == p] = x;
+    _nodes[x].parent = g;
+
+    std::size_t moved = _nodes[x].child[!side];
+    _nodes[p].child[side] = moved;
+    if (moved != NONE)
+        _nodes[moved].parent = p;
+    _nodes[x].child[!side] = p;
+    _nodes[p].parent = x;
+
+    _pull(p);
+    _pull(x);
+}
+
+template<typename T, typename Compare> void link_cut_tree<T, Compare>::_splay(std::size_t x) {
+    // push pending reversals top-down along the splay path first
+    _stack.clear();
+    for (std::size_t y = x;; y = _nodes[y].parent) {
+        _stack.push_back(y);
+        if (_is_splay_root(y))
+            break;
+    }
+    for (auto it = _stack.rbegin(); it != _stack.rend(); ++it)
+        _push(*it);
+
+    while (!_is_splay_root(x)) {
+        std::size_t p = _nodes[x].parent;
+        if (!_is_splay_root(p)) {
+            std::size_t g = _nodes[p].parent;
+            bool zig_zig = (_nodes[g].child[1] == p) == (_nodes[p].child[1] == x);
+            _rotate(zig_zig ? p : x);
+        }
+        _rotate(x);
+    }
+}
+
+template<typename T, typename Compare> void link_cut_tree<T, Compare>::_access(std::size_t x) {
+    // make the root-to-x path preferred, with x at its deep end
+    std::size_t last = NONE;
+    for (std::size_t y = x; y != NONE; y = _nodes[y].parent) {
+        _splay(y);
+        _nodes[y].child[1] = last;
+        _pull(y);
+        last = y;
+    }
+    _splay(x);
+}
+
+template<typename T, typename Compare>
+void link_cut_tree<T, Compare>::_make_root(std::size_t x) {
+    _access(x);
+    _nodes[x].reversed = !_nodes[x].reversed;
+    _push(x);
+}
+
+template<typename T, typename Compare>
+std::size_t link_cut_tree<T, Compare>::_find_root(std::size_t x) {
+    _access(x);
+    while (true) {
+        _push(x);
+        if (_nodes[x].child[0] == NONE)
+            break;
+        x = _nodes[x].child[0];
+    }
+    _splay(x);
+    return x;
+}
+
+template<typename T, typename Compare>
+void link_cut_tree<T, Compare>::_check(std::size_t x) const {
+    if (x >= _nodes.size())
+        throw std::out_of_range("No such node");
+}
+
+#endif // LINK_CUT_TREE_TPP
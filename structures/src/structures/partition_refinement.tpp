@@ -0,0 +1,241 @@
+#ifndef PARTITION_REFINEMENT_TPP
+#define PARTITION_REFINEMENT_TPP
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+template<typename Index>
+partition_refinement<Index>::partition_refinement(Index n, placement where) :
+    partition_refinement(_identity(n), where) {}
+
+template<typename Index>
+partition_refinement<Index>::partition_refinement(const std::vector<Index>& order,
+                                                  placement where) :
+    _where(where),
+    _next(order.size(), NONE),
+    _prev(order.size(), NONE),
+    _class(order.size(), NONE),
+    _first_class(NONE),
+    _last_class(NONE),
+    _front_key(0),
+    _num_elements(0),
+    _num_classes(0) {
+    if (order.empty())
+        return;
+    Index set = _new_class();
+    _insert_class(set, NONE);
+    for (Index item : order) {
+        _check(item);
+        if (_class[item] != NONE)
+            throw std::invalid_argument("Not a permutation");
+        _append(set, item);
+    }
+}
+
+template<typename Index>
+template<typename InputIt>
+void partition_refinement<Index>::refine(InputIt first, InputIt last) {
+    refine(first, last, [](Index, Index) {});
+}
+
+template<typename Index>
+template<typename InputIt, typename SplitFunction>
+void partition_refinement<Index>::refine(InputIt first, InputIt last, SplitFunction on_split) {
+    // _split[set] is the class receiving the moved part of set; a class created by this call is
+    // marked as its own split so that repeated elements stay where they are
+    _touched.clear();
+    for (; first != last; ++first) {
+        Index item = *first;
+        _check(item);
+        Index set = _class[item];
+        if (set == NONE || _split[set] == set)
+            continue;
+        if (_split[set] == NONE) {
+            Index part = _new_class();
+            _split[set] = _split[part] = part;
+            _touched.push_back(set);
+        }
+        _unlink(item);
+        _append(_split[set], item);
+    }
+
+    if (_where == placement::to_front)
+        std::sort(_touched.begin(), _touched.end(),
+                  [this](Index x, Index y) { return _key[x] < _key[y]; });
+    std::int64_t key = _front_key - static_cast<std::int64_t>(_touched.size());
+    _front_key = key;
+    Index previous = NONE;
+    for (Index set : _touched) {
+        Index part = _split[set];
+        _split[part] = NONE;
+        if (_where == placement::in_place) {
+            _insert_class(part, set);
+            _key[part] = _key[set];
+        } else {
+            _insert_class(part, previous == NONE ? _first_class : _next_class[previous]);
+            _key[part] = key++;
+            previous = part;
+        }
+
+        if (_size[set] == 0) {
+            _unlink_class(set);
+            _free_class(set);
+        }
+    }
+
+    // the splits are reported once every class is back in place
+    for (Index set : _touched) {
+        Index part = _split[set];
+        _split[set] = NONE;
+        if (_head[set] != NONE)
+            on_split(set, part);
+    }
+}
+
+template<typename Index> void partition_refinement<Index>::remove(Index item) {
+    _check(item);
+    Index set = _class[item];
+    if (set == NONE)
+        return;
+    _unlink(item);
+    if (_size[set] == 0) {
+        _unlink_class(set);
+        _free_class(set);
+    }
+}
+
+template<typename Index> bool partition_refinement<Index>::contains(Index item) const noexcept {
+    return item < _class.size() && _class[item] != NONE;
+}
+
+template<typename Index> Index partition_refinement<Index>::front() const noexcept {
+    return _first_class == NONE ? NONE : _head[_first_class];
+}
+
+template<typename Index> Index partition_refinement<Index>::first_class() const noexcept {
+    return _first_class;
+}
+
+template<typename Index> Index partition_refinement<Index>::next_class(Index set) const {
+    return _next_class.at(set);
+}
+
+template<typename Index> Index partition_refinement<Index>::first_element(Index set) const {
+    return _head.at(set);
+}
+
+template<typename Index> Index partition_refinement<Index>::next_element(Index item) const {
+    _check(item);
+    return _next[item];
+}
+
+template<typename Index> Index partition_refinement<Index>::class_of(Index item) const {
+    _check(item);
+    return _class[item];
+}
+
+template<typename Index> Index partition_refinement<Index>::class_size(Index set) const {
+    return _size.at(set);
+}
+
+template<typename Index> std::size_t partition_refinement<Index>::size() const noexcept {
+    return _num_elements;
+}
+
+template<typename Index> std::size_t partition_refinement<Index>::num_classes() const noexcept {
+    return _num_classes;
+}
+
+template<typename Index> std::vector<Index> partition_refinement<Index>::_identity(Index n) {
+    std::vector<Index> order(n);
+    std::iota(order.begin(), order.end(), Index(0));
+    return order;
+}
+
+template<typename Index> void partition_refinement<Index>::_append(Index set, Index item) {
+    _prev[item] = _tail[set];
+    _next[item] = NONE;
+    if (_tail[set] == NONE)
+        _head[set] = item;
+    else
+        _next[_tail[set]] = item;
+    _tail[set] = item;
+    _class[item] = set;
+    ++_size[set];
+    ++_num_elements;
+}
+
+template<typename Index> void partition_refinement<Index>::_unlink(Index item) {
+    Index set = _class[item];
+    if (_prev[item] == NONE)
+        _head[set] = _next[item];
+    else
+        _next[_prev[item]] = _next[item];
+    if (_next[item] == NONE)
+        _tail[set] = _prev[item];
+    else
+        _prev[_next[item]] = _prev[item];
+    _next[item] = _prev[item] = _class[item] = NONE;
+    --_size[set];
+    --_num_elements;
+}
+
+template<typename Index> Index partition_refinement<Index>::_new_class() {
+    ++_num_classes;
+    if (!_free.empty()) {
+        Index set = _free.back();
+        _free.pop_back();
+        return set;
+    }
+
+    Index set = static_cast<Index>(_head.size());
+    _head.push_back(NONE);
+    _tail.push_back(NONE);
+    _size.push_back(0);
+    _next_class.push_back(NONE);
+    _prev_class.push_back(NONE);
+    _split.push_back(NONE);
+    _key.push_back(0);
+    return set;
+}
+
+template<typename Index> void partition_refinement<Index>::_free_class(Index set) {
+    _head[set] = _tail[set] = NONE;
+    _free.push_back(set);
+    --_num_classes;
+}
+
+template<typename Index>
+void partition_refinement<Index>::_insert_class(Index set, Index before) {
+    Index after = before == NONE ? _last_class : _prev_class[before];
+    _prev_class[set] = after;
+    _next_class[set] = before;
+    if (after == NONE)
+        _first_class = set;
+    else
+        _next_class[after] = set;
+    if (before == NONE)
+        _last_class = set;
+    else
+        _prev_class[before] = set;
+}
+
+template<typename Index> void partition_refinement<Index>::_unlink_class(Index set) {
+    if (_prev_class[set] == NONE)
+        _first_class = _next_class[set];
+    else
+        _next_class[_prev_class[set]] = _next_class[set];
+    if (_next_class[set] == NONE)
+        _last_class = _prev_class[set];
+    else
+        _prev_class[_next_class[set]] = _prev_class[set];
+    _next_class[set] = _prev_class[set] = NONE;
+}
+
+template<typename Index> void partition_refinement<Index>::_check(Index item) const {
+    if (item >= _class.size())
+        throw std::out_of_range("No such element");
+}
+
+#endif // PARTITION_REFINEMENT_TPP
@@ -1,5 +1,6 @@
 #include <cmath>
 #include <fstream>
+#include <numeric>
 #include <random>
 #include <unordered_set>
 
@@ -7,21 +8,40 @@
 
 #include <algebra/algebra.h>
 
+#include <approx/npc_graph.h>
+
 #include <npc/CDCL.h>
+#include <npc/clique.h>
 #include <npc/karp/certificate.h>
 #include <npc/karp/reduction.h>
+#include <npc/vertex_cover.h>
 
 #include <structures/graph.h>
 
+#include <graph/bipartite.h>
+#include <graph/centrality.h>
+#include <graph/chordal.h>
 #include <graph/closure.h>
+#include <graph/coloring.h>
+#include <graph/components.h>
+#include <graph/cut_tree.h>
+#include <graph/dynamic_spanning_tree.h>
 #include <graph/max_flow_min_cut.h>
 #include <graph/order_dimension.h>
+#include <graph/orientation.h>
+#include <graph/pagerank.h>
+#include <graph/reachability.h>
 #include <graph/search.h>
+#include <graph/spanning_tree.h>
+#include <graph/triangles.h>
 
 #include <special_case/model.h>
 #include <special_case/model_gen.h>
 
 #include <structures/B_tree.h>
+#include <structures/disjoint_set.h>
+
+#include <util/parallel.h>
 
 #include "CNF_reader.h"
 #include "generator.h"
@@ -34,6 +54,45 @@ class AlgorithmTest : public ::testing::Test {
         std::random_device base;
         engine = std::mt19937_64(base());
     }
+
+    // Adjacency lists in CSR form, with unit weights
+    static util::csr_graph<double>
+      to_csr(const std::vector<std::vector<std::size_t>>& adjacency) {
+        util::csr_graph<double> csr;
+        csr.offsets.push_back(0);
+        for (const std::vector<std::size_t>& list : adjacency) {
+            csr.targets.insert(csr.targets.end(), list.begin(), list.end());
+            csr.offsets.push_back(csr.targets.size());
+        }
+        csr.weights.assign(csr.targets.size(), 1);
+        return csr;
+    }
+
+    // m edges between uniformly random endpoints, loops and parallel edges included, stored in
+    // both directions unless directed (loops once); integer weights uniform in [1, max_weight]
+    util::csr_graph<double> random_csr(std::size_t n, std::size_t m, bool directed = false,
+                                       int max_weight = 1) {
+        std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+        std::uniform_int_distribution<int> weight_dist(1, max_weight);
+        std::vector<std::vector<std::pair<std::size_t, double>>> adjacency(n);
+        for (std::size_t i = 0; i < m; ++i) {
+            std::size_t u = vertex_dist(engine), v = vertex_dist(engine);
+            double weight = weight_dist(engine);
+            adjacency[u].emplace_back(v, weight);
+            if (!directed && u != v)
+                adjacency[v].emplace_back(u, weight);
+        }
+        util::csr_graph<double> csr;
+        csr.offsets.push_back(0);
+        for (const std::vector<std::pair<std::size_t, double>>& list : adjacency) {
+            for (const std::pair<std::size_t, double>& edge : list) {
+                csr.targets.push_back(edge.first);
+                csr.weights.push_back(edge.second);
+            }
+            csr.offsets.push_back(csr.targets.size());
+        }
+        return csr;
+    }
 };
 
 TEST_F(AlgorithmTest, Circle_Graph_Clique) {
@@ -554,6 +613,2003 @@ TEST_F(AlgorithmTest, Max_Flow_Karzanov) {
     verify_undirected_min_cut(graph_alg::Karzanov_max_flow<int, false, double>, engine);
 }
 
+TEST_F(AlgorithmTest, Gomory_Hu_Tree) {
+    for (uint32_t i = 0; i < 50; ++i) {
+        graph::graph<int, false, true> input = random_graph<false, true>(engine);
+        graph::graph<int, false, true> tree = graph_alg::Gomory_Hu_tree(input);
+        ASSERT_EQ(tree.order(), input.order());
+
+        std::vector<int> vertices = input.vertices();
+        if (vertices.size() > 1) {
+            std::size_t tree_degrees = 0;
+            for (int v : vertices)
+                tree_degrees += tree.degree(v);
+            EXPECT_EQ(tree_degrees, 2 * (vertices.size() - 1));
+
+            std::uniform_int_distribution<uint32_t> vertex_picker(0, vertices.size() - 1);
+            for (uint32_t j = 0; j < 10; ++j) {
+                uint32_t start_index = vertex_picker(engine);
+                uint32_t end_index = vertex_picker(engine);
+                while (end_index == start_index)
+                    end_index = vertex_picker(engine);
+
+                auto min_cut =
+                  graph_alg::minimum_cut(input, vertices[start_index], vertices[end_index],
+                                         graph_alg::Dinic_max_flow<int, false, double>);
+                double cut_cost =
+                  std::accumulate(min_cut.begin(), min_cut.end(), 0.,
+                                  [&input](double prev, const graph_alg::cut_edge<int>& curr) {
+                                      return prev + input.edge_cost(curr.start, curr.end);
+                                  });
+                EXPECT_NEAR(graph_alg::Gomory_Hu_min_cut(tree, vertices[start_index],
+                                                         vertices[end_index]),
+                            cut_cost, 1e-6);
+            }
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Hopcroft_Karp) {
+    std::uniform_int_distribution<uint32_t> side_size(1, 40);
+    std::bernoulli_distribution has_edge(0.1);
+    for (uint32_t i = 0; i < 50; ++i) {
+        // even vertices on one side, odd on the other
+        graph::graph<int, false, false> input;
+        uint32_t num_vertices = 2 * side_size(engine);
+        for (uint32_t v = 0; v < num_vertices; ++v)
+            input.add_vertex(v);
+        for (uint32_t u = 0; u < num_vertices; u += 2)
+            for (uint32_t v = 1; v < num_vertices; v += 2)
+                if (has_edge(engine))
+                    input.set_edge(u, v);
+
+        std::list<std::pair<int, int>> expected = graph_alg::maximum_bipartite_matching(input);
+        for (unsigned num_threads : {1U, 4U}) {
+            std::list<std::pair<int, int>> result =
+              graph_alg::Hopcroft_Karp_matching(input, num_threads);
+            EXPECT_EQ(result.size(), expected.size());
+
+            std::unordered_set<int> used;
+            for (const std::pair<int, int>& e : result) {
+                EXPECT_TRUE(input.has_edge(e.first, e.second));
+                EXPECT_TRUE(used.insert(e.first).second);
+                EXPECT_TRUE(used.insert(e.second).second);
+            }
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Assignment) {
+    std::uniform_int_distribution<int> cost_dist(-50, 50);
+    std::uniform_int_distribution<std::size_t> small_size(1, 6);
+    for (uint32_t i = 0; i < 200; ++i) {
+        // brute force over every injection of the smaller side
+        std::size_t rows = small_size(engine), cols = small_size(engine);
+        dynamic_matrix<int> cost(rows, cols);
+        for (std::size_t r = 0; r < rows; ++r)
+            for (std::size_t c = 0; c < cols; ++c)
+                cost[r][c] = cost_dist(engine);
+
+        std::vector<std::size_t> result = graph_alg::Hungarian_assignment(cost);
+        ASSERT_EQ(result.size(), rows);
+        int total = 0;
+        std::unordered_set<std::size_t> used;
+        for (std::size_t r = 0; r < rows; ++r) {
+            if (result[r] == cols)
+                continue;
+            EXPECT_TRUE(used.insert(result[r]).second);
+            total += cost[r][result[r]];
+        }
+        EXPECT_EQ(used.size(), std::min(rows, cols));
+
+        std::vector<std::size_t> perm(std::max(rows, cols));
+        std::iota(perm.begin(), perm.end(), 0);
+        int best = std::numeric_limits<int>::max();
+        do {
+            int sum = 0;
+            for (std::size_t k = 0; k < std::min(rows, cols); ++k)
+                sum += rows <= cols ? cost[k][perm[k]] : cost[perm[k]][k];
+            best = std::min(best, sum);
+        } while (std::next_permutation(perm.begin(), perm.end()));
+        EXPECT_EQ(total, best);
+    }
+
+    std::uniform_int_distribution<std::size_t> large_size(1, 400);
+    std::bernoulli_distribution has_edge(0.2);
+    for (uint32_t i = 0; i < 30; ++i) {
+        // sparse instance with a guaranteed complete assignment, compared with the dense solver
+        std::size_t persons = large_size(engine);
+        std::size_t objects = persons + large_size(engine) % 3 * large_size(engine) / 4;
+        dynamic_matrix<int> dense(persons, objects, 1000000);
+        std::vector<std::size_t> offsets(1, 0), targets;
+        std::vector<int> costs;
+        for (std::size_t u = 0; u < persons; ++u) {
+            for (std::size_t v = 0; v < objects; ++v)
+                if (v == u || has_edge(engine)) {
+                    targets.push_back(v);
+                    costs.push_back(cost_dist(engine));
+                    dense[u][v] = costs.back();
+                }
+            offsets.push_back(targets.size());
+        }
+
+        std::vector<std::size_t> expected = graph_alg::Hungarian_assignment(dense);
+        int expected_total = 0;
+        for (std::size_t u = 0; u < persons; ++u)
+            expected_total += dense[u][expected[u]];
+
+        for (unsigned num_threads : {1U, 4U}) {
+            std::vector<std::size_t> result =
+              graph_alg::auction_assignment(objects, offsets, targets, costs, num_threads);
+            ASSERT_EQ(result.size(), persons);
+            int total = 0;
+            std::unordered_set<std::size_t> used;
+            for (std::size_t u = 0; u < persons; ++u) {
+                EXPECT_TRUE(used.insert(result[u]).second);
+                auto it = std::find(targets.begin() + offsets[u], targets.begin() + offsets[u + 1],
+                                    result[u]);
+                ASSERT_NE(it, targets.begin() + offsets[u + 1]);
+                total += costs[it - targets.begin()];
+            }
+            EXPECT_EQ(total, expected_total);
+        }
+    }
+
+    // two persons competing for one object
+    EXPECT_THROW(graph_alg::auction_assignment(2, {0, 1, 2}, {0, 0}, std::vector<int>{1, 2}),
+                 std::domain_error);
+}
+
+TEST_F(AlgorithmTest, Disjoint_Sets) {
+    std::uniform_int_distribution<std::size_t> size_dist(1, 100);
+    std::uniform_int_distribution<int> operation(0, 9);
+    for (uint32_t i = 0; i < 50; ++i) {
+        // naive partition: label[v] is the id of the set of v, relabeled on every union
+        std::size_t n = size_dist(engine);
+        std::vector<std::size_t> label(n);
+        std::iota(label.begin(), label.end(), 0);
+        dense_disjoint_set<uint32_t> sets(n);
+
+        for (uint32_t j = 0; j < 300; ++j) {
+            if (operation(engine) == 0) {
+                EXPECT_EQ(sets.insert(), label.size());
+                label.push_back(label.size());
+                continue;
+            }
+            std::uniform_int_distribution<uint32_t> element(0, label.size() - 1);
+            uint32_t a = element(engine), b = element(engine);
+            std::size_t joined = label[a], removed = label[b];
+            EXPECT_EQ(sets.union_sets(a, b), joined != removed);
+            for (std::size_t& l : label)
+                if (l == removed)
+                    l = joined;
+
+            uint32_t c = element(engine), d = element(engine);
+            EXPECT_EQ(sets.find(c) == sets.find(d), label[c] == label[d]);
+            EXPECT_EQ(sets.root(c), sets.find(c));
+            EXPECT_EQ(sets.set_size(c), std::count(label.begin(), label.end(), label[c]));
+            EXPECT_EQ(sets.size(), label.size());
+            EXPECT_EQ(sets.num_sets(), std::unordered_set<std::size_t>(label.begin(), label.end())
+                                         .size());
+        }
+    }
+
+    // concurrent unions end in the same partition as sequential ones
+    for (uint32_t i = 0; i < 10; ++i) {
+        std::size_t n = 2000;
+        std::uniform_int_distribution<uint32_t> element(0, n - 1);
+        std::vector<std::pair<uint32_t, uint32_t>> unions(1500);
+        for (std::pair<uint32_t, uint32_t>& p : unions)
+            p = {element(engine), element(engine)};
+
+        dense_disjoint_set<uint32_t> expected(n);
+        for (const std::pair<uint32_t, uint32_t>& p : unions)
+            expected.union_sets(p.first, p.second);
+
+        concurrent_disjoint_set<uint32_t> sets(n);
+        std::vector<std::size_t> joined(4, 0);
+        util::parallel_for(0, unions.size(), 4, [&](unsigned id, std::size_t k) {
+            joined[id] += sets.union_sets(unions[k].first, unions[k].second);
+        });
+        EXPECT_EQ(sets.size(), n);
+        EXPECT_EQ(std::accumulate(joined.begin(), joined.end(), std::size_t(0)),
+                  n - expected.num_sets());
+        for (uint32_t u = 0; u < n; ++u) {
+            EXPECT_EQ(sets.find(sets.find(u)), sets.find(u));
+            for (uint32_t v : {element(engine), element(engine), expected.root(u)})
+                EXPECT_EQ(sets.same_set(u, v), expected.find(u) == expected.find(v));
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Minimum_Spanning_Forests) {
+    std::uniform_int_distribution<std::size_t> size_dist(0, 300);
+    auto total_weight = [](const graph::graph<int, false, true>& tree) {
+        double total = 0;
+        for (int v : tree.vertices())
+            for (const std::pair<int, double>& e : tree.edges(v))
+                total += e.second;
+        return total / 2;
+    };
+
+    // Kruskal and Boruvka span every component with the same weight
+    for (uint32_t i = 0; i < 50; ++i) {
+        graph::graph<int, false, true> input =
+          random_graph<false, true>(engine, true, graph::adj_list, size_dist(engine));
+        std::size_t num_components = graph_alg::connected_components(input).size();
+        graph::graph<int, false, true> Kruskal = graph_alg::minimum_spanning_Kruskal(input),
+                                       Boruvka = graph_alg::minimum_spanning_Boruvka(input);
+        for (const graph::graph<int, false, true>* forest : {&Kruskal, &Boruvka}) {
+            EXPECT_EQ(forest->order(), input.order());
+            std::size_t num_edges = 0;
+            for (int v : forest->vertices())
+                num_edges += forest->degree(v);
+            EXPECT_EQ(num_edges / 2, input.order() - num_components);
+            EXPECT_EQ(graph_alg::connected_components(*forest).size(), num_components);
+        }
+        EXPECT_NEAR(total_weight(Boruvka), total_weight(Kruskal), 1e-6);
+    }
+}
+
+TEST_F(AlgorithmTest, Parallel_Boruvka) {
+    std::uniform_int_distribution<std::size_t> size_dist(0, 300);
+    auto total_weight = [](const graph::graph<int, false, true>& tree) {
+        double total = 0;
+        for (int v : tree.vertices())
+            for (const std::pair<int, double>& e : tree.edges(v))
+                total += e.second;
+        return total / 2;
+    };
+
+    for (uint32_t i = 0; i < 50; ++i) {
+        graph::graph<int, false, true> input =
+          random_graph<false, true>(engine, true, graph::adj_list, size_dist(engine));
+        graph::graph<int, false, true> expected = graph_alg::minimum_spanning_Kruskal(input);
+        std::size_t num_components = graph_alg::connected_components(input).size();
+
+        for (unsigned num_threads : {1U, 4U}) {
+            graph::graph<int, false, true> result =
+              graph_alg::minimum_spanning_Boruvka(input, num_threads);
+            EXPECT_EQ(result.order(), input.order());
+            std::size_t num_edges = 0;
+            for (int v : result.vertices())
+                num_edges += result.degree(v);
+            EXPECT_EQ(num_edges / 2, input.order() - num_components);
+            EXPECT_EQ(graph_alg::connected_components(result).size(), num_components);
+            EXPECT_NEAR(total_weight(result), total_weight(expected), 1e-6);
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Filter_Kruskal) {
+    std::uniform_int_distribution<std::size_t> size_dist(0, 300);
+    for (uint32_t i = 0; i < 50; ++i) {
+        graph::graph<int, false, true> input =
+          random_graph<false, true>(engine, true, graph::adj_list, size_dist(engine));
+        graph::graph<int, false, true> expected = graph_alg::minimum_spanning_Prim(input);
+
+        for (unsigned num_threads : {1U, 4U}) {
+            graph::graph<int, false, true> result =
+              graph_alg::minimum_spanning_Kruskal(input, num_threads);
+            EXPECT_EQ(result.order(), input.order());
+            for (int v : input.vertices()) {
+                std::list<std::pair<int, double>> actual_edges = result.edges(v),
+                                                  expected_edges = expected.edges(v);
+                actual_edges.sort();
+                expected_edges.sort();
+                EXPECT_EQ(actual_edges, expected_edges);
+            }
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Dynamic_Spanning_Forest) {
+    std::uniform_int_distribution<int> vertex_dist(0, 29);
+    std::uniform_real_distribution<double> weight_dist(0, 100);
+    std::uniform_int_distribution<int> operation(0, 2);
+    auto total_weight = [](const graph::graph<int, false, true>& tree) {
+        double total = 0;
+        for (int v : tree.vertices())
+            for (const std::pair<int, double>& e : tree.edges(v))
+                total += e.second;
+        return total / 2;
+    };
+
+    for (uint32_t i = 0; i < 20; ++i) {
+        graph::graph<int, false, true> input =
+          random_graph<false, true>(engine, true, graph::adj_list, 30);
+        graph_alg::dynamic_spanning_forest<int> forest(input);
+
+        for (uint32_t j = 0; j < 200; ++j) {
+            int u = vertex_dist(engine), v = vertex_dist(engine);
+            if (u == v)
+                continue;
+            double weight = weight_dist(engine);
+            switch (operation(engine)) {
+            case 0:
+                if (input.has_edge(u, v)) {
+                    input.remove_edge(u, v);
+                    forest.remove_edge(u, v);
+                } else {
+                    input.set_edge(u, v, weight);
+                    forest.insert_edge(u, v, weight);
+                }
+                break;
+            default:
+                if (input.has_edge(u, v)) {
+                    input.set_edge(u, v, weight);
+                    forest.set_weight(u, v, weight);
+                }
+                break;
+            }
+
+            graph::graph<int, false, true> expected = graph_alg::minimum_spanning_Kruskal(input);
+            graph::graph<int, false, true> result = forest.forest();
+            EXPECT_NEAR(forest.total_weight(), total_weight(expected), 1e-6);
+            EXPECT_NEAR(total_weight(result), total_weight(expected), 1e-6);
+            EXPECT_EQ(graph_alg::connected_components(result).size(),
+                      graph_alg::connected_components(input).size());
+            for (int x : result.vertices())
+                for (int y : result.neighbors(x))
+                    EXPECT_TRUE(input.has_edge(x, y));
+        }
+    }
+
+    // long forest paths with few non-forest edges: cuts split off halves of every size
+    std::uniform_int_distribution<int> long_dist(0, 299);
+    for (uint32_t i = 0; i < 5; ++i) {
+        graph::graph<int, false, true> input;
+        for (int v = 0; v < 300; ++v)
+            input.add_vertex(v);
+        for (int v = 1; v < 300; ++v)
+            input.set_edge(v - 1, v, weight_dist(engine));
+        for (uint32_t j = 0; j < 30; ++j) {
+            int u = long_dist(engine), v = long_dist(engine);
+            if (u != v && !input.has_edge(u, v))
+                input.set_edge(u, v, weight_dist(engine));
+        }
+        graph_alg::dynamic_spanning_forest<int> forest(input);
+
+        for (uint32_t j = 0; j < 100; ++j) {
+            int u = long_dist(engine);
+            std::list<int> adjacent = input.neighbors(u);
+            std::vector<int> neighbors(adjacent.begin(), adjacent.end());
+            if (neighbors.empty())
+                continue;
+            int v = neighbors[std::uniform_int_distribution<std::size_t>(
+              0, neighbors.size() - 1)(engine)];
+            if (j % 3 == 0) {
+                input.remove_edge(u, v);
+                forest.remove_edge(u, v);
+            } else {
+                double weight = weight_dist(engine);
+                input.set_edge(u, v, weight);
+                forest.set_weight(u, v, weight);
+            }
+            EXPECT_NEAR(forest.total_weight(),
+                        total_weight(graph_alg::minimum_spanning_Kruskal(input)), 1e-6);
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Parallel_Components) {
+    std::uniform_int_distribution<std::size_t> size_dist(0, 500);
+    std::bernoulli_distribution sparse(0.5);
+    for (uint32_t i = 0; i < 50; ++i) {
+        graph::graph<int, false, false> input;
+        std::size_t n = size_dist(engine);
+        if (sparse(engine)) {
+            // mostly isolated vertices and small components
+            std::uniform_int_distribution<int> vertex_dist(0, std::max<int>(n, 1) - 1);
+            for (std::size_t v = 0; v < n; ++v)
+                input.add_vertex(v);
+            for (std::size_t j = 0; j < n / 2; ++j) {
+                int u = vertex_dist(engine), v = vertex_dist(engine);
+                if (u != v)
+                    input.set_edge(u, v);
+            }
+        } else {
+            input = random_graph<false, false>(engine, true, graph::adj_list, n);
+        }
+
+        std::list<std::unordered_set<int>> expected = graph_alg::connected_components(input);
+        std::unordered_map<int, const std::unordered_set<int>*> expected_component;
+        for (const std::unordered_set<int>& component : expected)
+            for (int v : component)
+                expected_component[v] = &component;
+
+        for (unsigned num_threads : {1U, 4U}) {
+            std::list<std::unordered_set<int>> result =
+              graph_alg::connected_components(input, num_threads);
+            EXPECT_EQ(result.size(), expected.size());
+            for (const std::unordered_set<int>& component : result)
+                EXPECT_EQ(component, *expected_component.at(*component.begin()));
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Strongly_Connected_Condensation) {
+    auto check = [](const util::csr_graph<double>& input, const graph_alg::condensation& scc) {
+        // every DAG edge goes from a higher id to a lower one, and accounts for the input edges
+        std::size_t crossing = 0;
+        for (std::size_t u = 0; u < input.order(); ++u)
+            for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j)
+                crossing += scc.component[u] != scc.component[input.targets[j]];
+        std::size_t total = 0;
+        for (std::size_t c = 0; c < scc.size(); ++c)
+            for (std::size_t j = scc.dag.offsets[c]; j < scc.dag.offsets[c + 1]; ++j) {
+                EXPECT_LT(scc.dag.targets[j], c);
+                total += scc.dag.weights[j];
+            }
+        EXPECT_EQ(total, crossing);
+    };
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        graph::graph<int, true, true> input = random_graph<true, true>(engine);
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        graph_alg::condensation scc = graph_alg::strongly_connected_condensation(csr);
+        check(csr, scc);
+
+        // same component exactly when mutually reachable
+        std::vector<int> vertices = input.vertices();
+        std::vector<std::vector<bool>> reach(vertices.size());
+        for (std::size_t u = 0; u < vertices.size(); ++u) {
+            reach[u].assign(vertices.size(), false);
+            reach[u][u] = true;
+            std::vector<std::size_t> queue(1, u);
+            for (std::size_t k = 0; k < queue.size(); ++k)
+                for (std::size_t j = csr.offsets[queue[k]]; j < csr.offsets[queue[k] + 1]; ++j)
+                    if (!reach[u][csr.targets[j]]) {
+                        reach[u][csr.targets[j]] = true;
+                        queue.push_back(csr.targets[j]);
+                    }
+        }
+        for (std::size_t u = 0; u < vertices.size(); ++u)
+            for (std::size_t v = 0; v < vertices.size(); ++v)
+                EXPECT_EQ(scc.component[u] == scc.component[v], reach[u][v] && reach[v][u]);
+
+        std::list<std::unordered_set<int>> components =
+          graph_alg::strongly_connected_components(input);
+        EXPECT_EQ(components.size(), scc.size());
+    }
+
+    // large enough for the forward-backward decomposition: chains of cycles with shortcuts
+    std::uniform_int_distribution<std::size_t> size_dist(10000, 30000);
+    for (uint32_t i = 0; i < 5; ++i) {
+        std::size_t n = size_dist(engine);
+        std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+        std::vector<std::vector<std::size_t>> adjacency(n);
+        for (std::size_t v = 0; v + 1 < n; ++v)
+            adjacency[v].push_back(v + 1);
+        for (std::size_t k = 0; k < n / 4; ++k)
+            adjacency[vertex_dist(engine)].push_back(vertex_dist(engine));
+        util::csr_graph<double> csr = to_csr(adjacency);
+
+        graph_alg::condensation expected = graph_alg::strongly_connected_condensation(csr);
+        graph_alg::condensation result = graph_alg::strongly_connected_condensation(csr, 4);
+        check(csr, result);
+        ASSERT_EQ(result.size(), expected.size());
+        std::vector<std::size_t> mapping(expected.size(), n);
+        for (std::size_t v = 0; v < n; ++v) {
+            if (mapping[expected.component[v]] == n)
+                mapping[expected.component[v]] = result.component[v];
+            EXPECT_EQ(mapping[expected.component[v]], result.component[v]);
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Deep_Depth_First) {
+    // a path far deeper than any call stack would allow
+    const std::size_t depth = 1000000;
+    util::csr_graph<double> chain;
+    for (std::size_t v = 0; v < depth; ++v) {
+        chain.offsets.push_back(v);
+        chain.targets.push_back((v + 1) % depth);
+    }
+    chain.offsets.push_back(depth);
+    chain.weights.assign(depth, 1);
+
+    graph_alg::depth_first_state deep_state(depth);
+    std::size_t finished = 0;
+    graph_alg::depth_first_visit(
+      chain, 0, deep_state, [](std::size_t) {},
+      [](std::size_t, std::size_t, graph_alg::dfs_edge) {},
+      [&finished](std::size_t parent, std::size_t child) {
+          EXPECT_EQ(parent, child == 0 ? graph_alg::depth_first_state::NONE : child - 1);
+          ++finished;
+      });
+    EXPECT_EQ(finished, depth);
+    EXPECT_EQ(graph_alg::strongly_connected_condensation(chain).size(), 1);
+    // drop the edge closing the cycle
+    chain.targets.pop_back();
+    chain.weights.pop_back();
+    --chain.offsets.back();
+    EXPECT_EQ(graph_alg::strongly_connected_condensation(chain).size(), depth);
+
+    // graph wrappers on the same engine
+    const int n = 2000;
+    graph::graph<int, false, false> path;
+    graph::graph<int, true, false> cycle;
+    for (int i = 0; i < n; ++i) {
+        path.add_vertex(i);
+        cycle.add_vertex(i);
+    }
+    for (int i = 0; i + 1 < n; ++i) {
+        path.force_add(i, i + 1);
+        cycle.force_add(i, i + 1);
+    }
+    cycle.force_add(n - 1, 0);
+
+    int visited = 0, backtracked = 0;
+    graph_alg::depth_first(
+      path, 0, [&visited](int) { ++visited; },
+      [&backtracked](int parent, int child) {
+          EXPECT_EQ(parent + 1, child);
+          ++backtracked;
+      });
+    EXPECT_EQ(visited, n);
+    EXPECT_EQ(backtracked, n - 1);
+
+    int roots = 0;
+    graph_alg::depth_first_forest(
+      path, n / 2, [](int) {}, [](int, int) {}, [&roots](int) { ++roots; });
+    EXPECT_EQ(roots, 1);
+
+    std::unordered_set<int> cut_vertices = graph_alg::articulation_points(path);
+    EXPECT_EQ(cut_vertices.size(), n - 2);
+    EXPECT_EQ(cut_vertices.count(0), 0);
+    EXPECT_EQ(cut_vertices.count(n - 1), 0);
+
+    EXPECT_EQ(graph_alg::strongly_connected_components(cycle).size(), 1);
+    cycle.remove_edge(n - 1, 0);
+    EXPECT_EQ(graph_alg::strongly_connected_components(cycle).size(), n);
+
+    // edge classification
+    util::csr_graph<double> csr;
+    csr.offsets = {0, 2, 3, 4, 4};
+    csr.targets = {1, 3, 2, 0};
+    csr.weights.assign(csr.targets.size(), 1);
+    graph_alg::depth_first_state state(csr.order());
+    std::vector<graph_alg::dfs_edge> kinds;
+    graph_alg::depth_first_visit(
+      csr, 0, state, [](std::size_t) {},
+      [&kinds](std::size_t, std::size_t, graph_alg::dfs_edge kind) { kinds.push_back(kind); },
+      [](std::size_t, std::size_t) {});
+    std::vector<graph_alg::dfs_edge> expected = {graph_alg::dfs_edge::tree,
+                                                 graph_alg::dfs_edge::tree,
+                                                 graph_alg::dfs_edge::back,
+                                                 graph_alg::dfs_edge::tree};
+    EXPECT_EQ(kinds, expected);
+    state.reset(3);
+    kinds.clear();
+    graph_alg::depth_first_visit(
+      csr, 2, state, [](std::size_t) {},
+      [&kinds](std::size_t, std::size_t, graph_alg::dfs_edge kind) { kinds.push_back(kind); },
+      [](std::size_t, std::size_t) {});
+    EXPECT_EQ(kinds, std::vector<graph_alg::dfs_edge>(1, graph_alg::dfs_edge::cross));
+}
+
+TEST_F(AlgorithmTest, Biconnected_Components) {
+    auto num_components = [](const graph::graph<int, false, false>& input) {
+        return graph_alg::connected_components(input).size();
+    };
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        graph::graph<int, false, false> input = random_graph<false, false>(engine);
+        std::vector<int> vertices = input.vertices();
+        std::size_t n = vertices.size(), base = num_components(input);
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        graph_alg::block_decomposition blocks = graph_alg::biconnected_blocks(csr);
+
+        // cut vertices and bridges against removal
+        std::unordered_set<int> cut_vertices = graph_alg::articulation_points(input);
+        for (std::size_t v = 0; v < n; ++v) {
+            graph::graph<int, false, false> copy(input);
+            copy.remove(vertices[v]);
+            bool expected = num_components(copy) > base;
+            EXPECT_EQ(cut_vertices.count(vertices[v]) != 0, expected);
+            EXPECT_EQ(std::binary_search(blocks.cut_vertices.begin(), blocks.cut_vertices.end(), v),
+                      expected);
+        }
+        std::list<std::pair<int, int>> bridges = graph_alg::bridges(input);
+        std::size_t num_bridges = 0;
+        for (std::size_t u = 0; u < n; ++u)
+            for (int w : input.neighbors(vertices[u])) {
+                if (w < vertices[u])
+                    continue;
+                graph::graph<int, false, false> copy(input);
+                copy.remove_edge(vertices[u], w);
+                bool expected = num_components(copy) > base;
+                num_bridges += expected;
+                EXPECT_EQ(std::count_if(bridges.begin(), bridges.end(),
+                                        [&](const std::pair<int, int>& e) {
+                                            return std::minmax(e.first, e.second) ==
+                                                   std::minmax(vertices[u], w);
+                                        }),
+                          expected);
+            }
+        EXPECT_EQ(bridges.size(), num_bridges);
+
+        // both directions of an edge agree, and blocks overlap only at cut vertices
+        std::vector<graph::graph<int, false, false>> block_graphs(blocks.size());
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t j = csr.offsets[u]; j < csr.offsets[u + 1]; ++j) {
+                std::size_t w = csr.targets[j];
+                std::size_t back = std::find(csr.targets.begin() + csr.offsets[w],
+                                             csr.targets.begin() + csr.offsets[w + 1], u) -
+                                   csr.targets.begin();
+                ASSERT_EQ(blocks.edge_block[j], blocks.edge_block[back]);
+                graph::graph<int, false, false>& block = block_graphs[blocks.edge_block[j]];
+                for (std::size_t x : {u, w})
+                    if (!block.has_vertex(vertices[x]))
+                        block.add_vertex(vertices[x]);
+                block.set_edge(vertices[u], vertices[w]);
+            }
+        for (std::size_t b = 0; b < blocks.size(); ++b) {
+            EXPECT_EQ(num_components(block_graphs[b]), 1);
+            EXPECT_TRUE(graph_alg::articulation_points(block_graphs[b]).empty());
+            for (std::size_t c = b + 1; c < blocks.size(); ++c) {
+                std::size_t shared = 0;
+                for (int v : block_graphs[b].vertices())
+                    if (block_graphs[c].has_vertex(v)) {
+                        ++shared;
+                        EXPECT_EQ(cut_vertices.count(v), 1);
+                    }
+                EXPECT_LE(shared, 1);
+            }
+        }
+        EXPECT_EQ(graph_alg::biconnected_components(input).size(), blocks.size());
+
+        // the block-cut tree is a spanning tree of each component with an edge
+        std::size_t nontrivial = 0;
+        for (const std::unordered_set<int>& component : graph_alg::connected_components(input))
+            nontrivial += component.size() > 1;
+        const util::csr_graph<std::size_t>& tree = blocks.block_cut_tree;
+        EXPECT_EQ(tree.order(), blocks.size() + blocks.cut_vertices.size());
+        EXPECT_EQ(tree.order() - tree.size() / 2, nontrivial);
+    }
+
+    // parallel edges are not bridges
+    util::csr_graph<double> csr;
+    csr.offsets = {0, 2, 5, 6};
+    csr.targets = {1, 1, 0, 0, 2, 1};
+    csr.weights.assign(csr.targets.size(), 1);
+    graph_alg::block_decomposition blocks = graph_alg::biconnected_blocks(csr);
+    EXPECT_EQ(blocks.size(), 2);
+    EXPECT_EQ(blocks.bridges, (std::vector<std::pair<std::size_t, std::size_t>>{{1, 2}}));
+    EXPECT_EQ(blocks.cut_vertices, std::vector<std::size_t>(1, 1));
+}
+
+TEST_F(AlgorithmTest, Bit_Transitive_Closure) {
+    for (int i = 0; i < 100; ++i) {
+        graph::graph<int, true, false> input =
+          random_graph<true, false>(engine, i % 2 == 0, graph::adj_list, 60);
+        std::vector<int> vertices = input.vertices();
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        graph_alg::reachability_closure closure = graph_alg::bit_transitive_closure(csr);
+
+        graph::graph<int, true, false> expected = graph_alg::transitive_closure_sparse(input);
+        for (std::size_t u = 0; u < vertices.size(); ++u)
+            for (std::size_t v = 0; v < vertices.size(); ++v)
+                EXPECT_EQ(closure.reaches(u, v),
+                          u == v || expected.has_edge(vertices[u], vertices[v]));
+
+        graph::graph<int, true, false> result = graph_alg::transitive_closure(input, 2);
+        for (int v : vertices) {
+            std::list<int> result_neighbors = result.neighbors(v),
+                           expected_neighbors = expected.neighbors(v);
+            result_neighbors.sort();
+            expected_neighbors.sort();
+            EXPECT_EQ(result_neighbors, expected_neighbors);
+        }
+    }
+
+    // layered DAG, wide enough to fill levels concurrently
+    const std::size_t width = 200, layers = 20, n = width * layers;
+    std::uniform_int_distribution<std::size_t> column(0, width - 1);
+    std::vector<std::vector<std::size_t>> adjacency(n);
+    for (std::size_t v = 0; v + width < n; ++v)
+        for (uint32_t j = 0; j < 3; ++j)
+            adjacency[v].push_back((v / width + 1) * width + column(engine));
+    util::csr_graph<double> csr = to_csr(adjacency);
+    graph_alg::reachability_closure serial = graph_alg::bit_transitive_closure(csr);
+    graph_alg::reachability_closure parallel = graph_alg::bit_transitive_closure(csr, 4);
+    for (std::size_t u = 0; u < n; u += 7) {
+        std::vector<bool> reach(n, false);
+        reach[u] = true;
+        std::vector<std::size_t> queue(1, u);
+        for (std::size_t k = 0; k < queue.size(); ++k)
+            for (std::size_t j = csr.offsets[queue[k]]; j < csr.offsets[queue[k] + 1]; ++j)
+                if (!reach[csr.targets[j]]) {
+                    reach[csr.targets[j]] = true;
+                    queue.push_back(csr.targets[j]);
+                }
+        for (std::size_t v = 0; v < n; ++v) {
+            EXPECT_EQ(serial.reaches(u, v), reach[v]);
+            EXPECT_EQ(parallel.reaches(u, v), reach[v]);
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Reachability_Index) {
+    for (int i = 0; i < 100; ++i) {
+        graph::graph<int, true, false> input =
+          random_graph<true, false>(engine, i % 2 == 0, graph::adj_list, 60);
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        graph_alg::reachability_closure closure = graph_alg::bit_transitive_closure(csr);
+        graph_alg::reachability_index index(csr, i % 4);
+        for (std::size_t u = 0; u < csr.order(); ++u)
+            for (std::size_t v = 0; v < csr.order(); ++v)
+                EXPECT_EQ(index.reaches(u, v), closure.reaches(u, v));
+    }
+
+    // sparse DAG with a few cycles
+    const std::size_t n = 20000;
+    std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+    std::vector<std::vector<std::size_t>> adjacency(n);
+    for (std::size_t k = 0; k < 2 * n; ++k) {
+        std::size_t u = vertex_dist(engine), v = vertex_dist(engine);
+        adjacency[std::min(u, v)].push_back(std::max(u, v));
+    }
+    for (std::size_t k = 0; k < 10; ++k)
+        adjacency[vertex_dist(engine)].push_back(vertex_dist(engine));
+    util::csr_graph<double> csr = to_csr(adjacency);
+
+    graph_alg::reachability_index index(csr, 3, 4);
+    for (std::size_t k = 0; k < 20; ++k) {
+        std::size_t u = vertex_dist(engine);
+        std::vector<bool> reach(n, false);
+        reach[u] = true;
+        std::vector<std::size_t> queue(1, u);
+        for (std::size_t q = 0; q < queue.size(); ++q)
+            for (std::size_t j = csr.offsets[queue[q]]; j < csr.offsets[queue[q] + 1]; ++j)
+                if (!reach[csr.targets[j]]) {
+                    reach[csr.targets[j]] = true;
+                    queue.push_back(csr.targets[j]);
+                }
+        for (std::size_t v = 0; v < n; ++v)
+            EXPECT_EQ(index.reaches(u, v), reach[v]);
+
+        // concurrent queries, each thread with its own scratch space
+        const graph_alg::reachability_index& shared = index;
+        std::vector<graph_alg::reachability_index::query_state> states(4);
+        std::vector<char> found(n);
+        util::parallel_for(
+          0, n, 4, [&](unsigned id, std::size_t v) { found[v] = shared.reaches(u, v, states[id]); },
+          64);
+        for (std::size_t v = 0; v < n; ++v)
+            EXPECT_EQ(static_cast<bool>(found[v]), reach[v]);
+    }
+}
+
+TEST_F(AlgorithmTest, Core_Decomposition) {
+    for (int i = 0; i < 100; ++i) {
+        graph::graph<int, false, false> input = random_graph<false, false>(engine);
+        std::vector<int> vertices = input.vertices();
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        std::vector<std::size_t> core = graph_alg::core_numbers(csr);
+        EXPECT_EQ(graph_alg::core_numbers(csr, 3), core);
+
+        std::size_t max_core = core.empty() ? 0 : *std::max_element(core.begin(), core.end());
+        for (uint32_t k = 0; k <= max_core + 1; ++k) {
+            // peel by hand
+            std::vector<std::size_t> degree(vertices.size());
+            std::vector<bool> in_core(vertices.size(), true);
+            for (std::size_t v = 0; v < vertices.size(); ++v)
+                degree[v] = csr.degree(v);
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (std::size_t v = 0; v < vertices.size(); ++v)
+                    if (in_core[v] && degree[v] < k) {
+                        in_core[v] = false;
+                        changed = true;
+                        for (std::size_t j = csr.offsets[v]; j < csr.offsets[v + 1]; ++j)
+                            --degree[csr.targets[j]];
+                    }
+            }
+
+            graph::graph<int, false, false> k_core = graph_alg::k_core(input, k);
+            for (std::size_t v = 0; v < vertices.size(); ++v) {
+                EXPECT_EQ(core[v] >= k, in_core[v]);
+                EXPECT_EQ(k_core.has_vertex(vertices[v]), in_core[v]);
+                EXPECT_TRUE(!in_core[v] || k_core.degree(vertices[v]) >= k);
+            }
+        }
+    }
+
+    // power-law-like graph, large enough for several peeling rounds
+    const std::size_t n = 20000;
+    std::vector<std::vector<std::size_t>> adjacency(n);
+    for (std::size_t v = 1; v < n; ++v) {
+        std::uniform_int_distribution<std::size_t> earlier(0, v - 1);
+        for (uint32_t j = 0; j < 1 + v % 7; ++j) {
+            std::size_t w = earlier(engine);
+            w = earlier(engine) % (w + 1);
+            adjacency[v].push_back(w);
+            adjacency[w].push_back(v);
+        }
+    }
+    util::csr_graph<double> csr = to_csr(adjacency);
+    EXPECT_EQ(graph_alg::core_numbers(csr, 4), graph_alg::core_numbers(csr));
+}
+
+TEST_F(AlgorithmTest, Topological_Levels) {
+    auto check = [](const util::csr_graph<double>& input,
+                    const graph_alg::topological_levels& levels) {
+        ASSERT_EQ(levels.order.size(), input.order());
+        std::vector<std::size_t> level(input.order(), input.order());
+        for (std::size_t l = 0; l < levels.num_levels(); ++l)
+            for (std::size_t i = levels.level_offsets[l]; i < levels.level_offsets[l + 1]; ++i)
+                level[levels.order[i]] = l;
+        // every edge goes to a later level, and every vertex past level 0 has a predecessor in
+        // the level just before it
+        std::vector<bool> tight(input.order(), false);
+        for (std::size_t u = 0; u < input.order(); ++u)
+            for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j) {
+                EXPECT_LT(level[u], level[input.targets[j]]);
+                if (level[u] + 1 == level[input.targets[j]])
+                    tight[input.targets[j]] = true;
+            }
+        for (std::size_t v = 0; v < input.order(); ++v)
+            EXPECT_EQ(tight[v], level[v] != 0);
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        graph::graph<int, true, false> input =
+          random_graph<true, false>(engine, i % 4 == 0, graph::adj_list, 60);
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        if (i % 4 == 0 && graph_alg::strongly_connected_condensation(csr).size() != csr.order()) {
+            EXPECT_THROW(graph_alg::Kahn_levels(csr), std::invalid_argument);
+            EXPECT_THROW(graph_alg::Kahn_levels(csr, 3), std::invalid_argument);
+            EXPECT_THROW(graph_alg::topological_sort(input), std::invalid_argument);
+            continue;
+        }
+        check(csr, graph_alg::Kahn_levels(csr));
+        check(csr, graph_alg::Kahn_levels(csr, 3));
+
+        std::vector<int> order = graph_alg::topological_sort(input);
+        std::unordered_map<int, std::size_t> position;
+        for (std::size_t j = 0; j < order.size(); ++j)
+            position[order[j]] = j;
+        for (int v : input.vertices())
+            for (int w : input.neighbors(v))
+                EXPECT_LT(position[v], position[w]);
+    }
+
+    // wide random DAG
+    const std::size_t n = 50000;
+    std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+    std::vector<std::vector<std::size_t>> adjacency(n);
+    for (std::size_t k = 0; k < 4 * n; ++k) {
+        std::size_t u = vertex_dist(engine), v = vertex_dist(engine);
+        if (u != v)
+            adjacency[std::min(u, v)].push_back(std::max(u, v));
+    }
+    util::csr_graph<double> csr = to_csr(adjacency);
+    graph_alg::topological_levels serial = graph_alg::Kahn_levels(csr),
+                                  parallel = graph_alg::Kahn_levels(csr, 4);
+    check(csr, parallel);
+    EXPECT_EQ(serial.level_offsets, parallel.level_offsets);
+}
+
+TEST_F(AlgorithmTest, Lex_Search_Partition_Refinement) {
+    // quadratic reference: explicit labels, compared lexicographically
+    auto reference = [](const util::csr_graph<double>& input,
+                        const std::vector<std::size_t>& initial_order, bool depth_first) {
+        std::size_t n = input.order();
+        std::vector<std::vector<std::size_t>> labels(n);
+        std::vector<bool> visited(n, false);
+        std::vector<std::size_t> result;
+        for (std::size_t step = 0; step < n; ++step) {
+            std::size_t best = n;
+            for (std::size_t v : initial_order)
+                if (!visited[v] && (best == n || labels[best] < labels[v]))
+                    best = v;
+            visited[best] = true;
+            result.push_back(best);
+            for (std::size_t j = input.offsets[best]; j < input.offsets[best + 1]; ++j) {
+                std::vector<std::size_t>& label = labels[input.targets[j]];
+                if (depth_first)
+                    label.insert(label.begin(), step);
+                else
+                    label.push_back(n - step);
+            }
+        }
+        return result;
+    };
+
+    for (int i = 0; i < 200; ++i) {
+        graph::graph<int, false, false> input = random_graph<false, false>(engine);
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        std::vector<std::size_t> initial_order(csr.order());
+        std::iota(initial_order.begin(), initial_order.end(), 0);
+        std::shuffle(initial_order.begin(), initial_order.end(), engine);
+
+        std::vector<std::size_t> bfs = graph_alg::lex_bfs(csr, initial_order);
+        EXPECT_EQ(bfs, reference(csr, initial_order, false));
+        EXPECT_EQ(graph_alg::lex_dfs(csr, initial_order), reference(csr, initial_order, true));
+        EXPECT_EQ(graph_alg::lex_bfs_plus(csr, bfs),
+                  reference(csr, std::vector<std::size_t>(bfs.rbegin(), bfs.rend()), false));
+
+        if (csr.order() != 0) {
+            std::list<int> dfs = graph_alg::generate_lex_dfs(input, input.vertices().back());
+            EXPECT_EQ(dfs.front(), input.vertices().back());
+            EXPECT_EQ(dfs.size(), input.order());
+        }
+    }
+
+    // directed: ranks come from in-neighbors
+    util::csr_graph<double> csr;
+    csr.offsets = {0, 1, 1, 2};
+    csr.targets = {2, 1};
+    csr.weights.assign(csr.targets.size(), 1);
+    EXPECT_EQ(graph_alg::lex_bfs(csr), (std::vector<std::size_t>{0, 2, 1}));
+    EXPECT_THROW(graph_alg::lex_bfs(csr, std::vector<std::size_t>{0, 0, 1}),
+                 std::invalid_argument);
+
+    partition_refinement<uint32_t> classes(6, partition_refinement<uint32_t>::placement::to_front);
+    std::vector<uint32_t> pivot = {4, 1, 4};
+    classes.refine(pivot.begin(), pivot.end());
+    EXPECT_EQ(classes.num_classes(), 2);
+    EXPECT_EQ(classes.front(), 4);
+    EXPECT_EQ(classes.next_element(4), 1);
+    classes.remove(4);
+    classes.remove(1);
+    EXPECT_EQ(classes.num_classes(), 1);
+    EXPECT_EQ(classes.front(), 0);
+    EXPECT_EQ(classes.size(), 4);
+    EXPECT_FALSE(classes.contains(1));
+}
+
+TEST_F(AlgorithmTest, Chordal_Graphs) {
+    auto adjacency_matrix = [](const util::csr_graph<double>& input) {
+        std::vector<std::vector<bool>> adjacent(input.order(),
+                                                std::vector<bool>(input.order(), false));
+        for (std::size_t u = 0; u < input.order(); ++u)
+            for (std::size_t j = input.offsets[u]; j < input.offsets[u + 1]; ++j)
+                adjacent[u][input.targets[j]] = true;
+        return adjacent;
+    };
+    // chordal exactly when simplicial vertices can be removed until nothing is left
+    auto brute_chordal = [](const std::vector<std::vector<bool>>& adjacent) {
+        std::size_t n = adjacent.size();
+        std::vector<bool> removed(n, false);
+        for (std::size_t round = 0; round < n; ++round) {
+            bool found = false;
+            for (std::size_t v = 0; v < n && !found; ++v) {
+                if (removed[v])
+                    continue;
+                bool simplicial = true;
+                for (std::size_t x = 0; x < n && simplicial; ++x)
+                    for (std::size_t y = x + 1; y < n && simplicial; ++y)
+                        if (!removed[x] && !removed[y] && adjacent[v][x] && adjacent[v][y])
+                            simplicial = adjacent[x][y];
+                if (simplicial) {
+                    removed[v] = true;
+                    found = true;
+                }
+            }
+            if (!found)
+                return false;
+        }
+        return true;
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        graph::graph<int, false, false> input = random_graph<false, false>(engine);
+        util::csr_graph<double> csr = util::get_csr_rep(input);
+        bool chordal = brute_chordal(adjacency_matrix(csr));
+        EXPECT_EQ(graph_alg::is_chordal(input), chordal);
+        if (!chordal) {
+            EXPECT_THROW(graph_alg::chordal_clique_tree(csr), std::domain_error);
+        }
+    }
+
+    // random chordal graphs: every new vertex joins part of the clique of an earlier one
+    std::uniform_int_distribution<std::size_t> size_dist(1, 14);
+    std::bernoulli_distribution coin(0.6);
+    for (int i = 0; i < 100; ++i) {
+        std::size_t n = size_dist(engine);
+        std::vector<std::vector<std::size_t>> earlier(n), adjacency(n);
+        for (std::size_t v = 1; v < n; ++v) {
+            if (!coin(engine))
+                continue;
+            std::size_t u = std::uniform_int_distribution<std::size_t>(0, v - 1)(engine);
+            std::vector<std::size_t> join(1, u);
+            for (std::size_t w : earlier[u])
+                if (coin(engine))
+                    join.push_back(w);
+            for (std::size_t w : join) {
+                earlier[v].push_back(w);
+                adjacency[v].push_back(w);
+                adjacency[w].push_back(v);
+            }
+        }
+        util::csr_graph<double> csr = to_csr(adjacency);
+        std::vector<std::vector<bool>> adjacent = adjacency_matrix(csr);
+        ASSERT_TRUE(graph_alg::is_chordal(csr));
+        std::vector<std::size_t> reverse_order(n);
+        std::iota(reverse_order.rbegin(), reverse_order.rend(), 0);
+        EXPECT_TRUE(graph_alg::is_perfect_elimination_order(csr, reverse_order));
+
+        // maximal cliques, each vertex in a subtree of the clique tree
+        graph_alg::clique_tree tree = graph_alg::chordal_clique_tree(csr);
+        std::size_t largest = 0;
+        std::vector<std::vector<bool>> member(tree.size(), std::vector<bool>(n, false));
+        for (std::size_t c = 0; c < tree.size(); ++c) {
+            largest = std::max(largest, tree.cliques[c].size());
+            for (std::size_t x : tree.cliques[c]) {
+                member[c][x] = true;
+                for (std::size_t y : tree.cliques[c])
+                    EXPECT_TRUE(x == y || adjacent[x][y]);
+            }
+            for (std::size_t v = 0; v < n; ++v) {
+                bool extends = !member[c][v];
+                for (std::size_t x : tree.cliques[c])
+                    extends = extends && adjacent[v][x];
+                EXPECT_FALSE(extends);
+            }
+        }
+        for (std::size_t v = 0; v < n; ++v) {
+            std::size_t containing = 0, tree_edges = 0;
+            for (std::size_t c = 0; c < tree.size(); ++c) {
+                containing += member[c][v];
+                if (tree.parent[c] != graph_alg::depth_first_state::NONE)
+                    tree_edges += member[c][v] && member[tree.parent[c]][v];
+            }
+            EXPECT_GE(containing, 1);
+            EXPECT_EQ(tree_edges + 1, containing);
+        }
+        for (std::size_t c = 0; c < tree.size(); ++c)
+            if (tree.parent[c] != graph_alg::depth_first_state::NONE) {
+                std::size_t shared = 0;
+                for (std::size_t x : tree.cliques[c])
+                    shared += member[tree.parent[c]][x];
+                EXPECT_EQ(shared, tree.separator_size[c]);
+            }
+
+        // optimal coloring and independent set
+        std::vector<std::size_t> color = graph_alg::chordal_coloring(csr);
+        for (std::size_t u = 0; u < n; ++u) {
+            EXPECT_LT(color[u], largest);
+            for (std::size_t v = 0; v < n; ++v)
+                EXPECT_TRUE(!adjacent[u][v] || color[u] != color[v]);
+        }
+        std::vector<std::size_t> independent = graph_alg::chordal_independent_set(csr);
+        for (std::size_t x : independent)
+            for (std::size_t y : independent)
+                EXPECT_FALSE(adjacent[x][y]);
+        std::size_t best = 0;
+        for (uint32_t subset = 0; subset < (1U << n); ++subset) {
+            bool valid = true;
+            for (std::size_t x = 0; x < n && valid; ++x)
+                for (std::size_t y = x + 1; y < n && valid; ++y)
+                    valid = !((subset >> x & 1) && (subset >> y & 1) && adjacent[x][y]);
+            if (valid)
+                best = std::max<std::size_t>(best, __builtin_popcount(subset));
+        }
+        EXPECT_EQ(independent.size(), best);
+    }
+}
+
+TEST_F(AlgorithmTest, Modular_Decomposition) {
+    typedef graph_alg::modular_decomposition_tree::node_type node_type;
+    auto from_matrix = [](const std::vector<std::vector<bool>>& adjacent) {
+        std::vector<std::vector<std::size_t>> adjacency(adjacent.size());
+        for (std::size_t u = 0; u < adjacent.size(); ++u)
+            for (std::size_t v = 0; v < adjacent.size(); ++v)
+                if (adjacent[u][v])
+                    adjacency[u].push_back(v);
+        return to_csr(adjacency);
+    };
+    auto is_module = [](const std::vector<std::vector<bool>>& adjacent, unsigned set) {
+        for (std::size_t x = 0; x < adjacent.size(); ++x) {
+            if (set >> x & 1)
+                continue;
+            int seen = -1;
+            for (std::size_t v = 0; v < adjacent.size(); ++v)
+                if (set >> v & 1) {
+                    if (seen != -1 && seen != adjacent[x][v])
+                        return false;
+                    seen = adjacent[x][v];
+                }
+        }
+        return true;
+    };
+    auto connected = [](const std::vector<std::vector<bool>>& adjacent, unsigned set, bool edge) {
+        unsigned reached = set & (~set + 1), previous = 0;
+        while (reached != previous) {
+            previous = reached;
+            for (std::size_t u = 0; u < adjacent.size(); ++u)
+                for (std::size_t v = 0; v < adjacent.size(); ++v)
+                    if ((reached >> u & 1) && (set >> v & 1) && u != v && adjacent[u][v] == edge)
+                        reached |= 1U << v;
+        }
+        return reached == set;
+    };
+    // some linear extension of the orientation is transitive
+    auto brute_comparability = [](const std::vector<std::vector<bool>>& adjacent) {
+        std::vector<std::size_t> order(adjacent.size());
+        std::iota(order.begin(), order.end(), 0);
+        do {
+            bool transitive = true;
+            for (std::size_t i = 0; i < order.size() && transitive; ++i)
+                for (std::size_t j = i + 1; j < order.size() && transitive; ++j)
+                    for (std::size_t l = j + 1; l < order.size() && transitive; ++l)
+                        transitive = !adjacent[order[i]][order[j]] ||
+                                     !adjacent[order[j]][order[l]] || adjacent[order[i]][order[l]];
+            if (transitive)
+                return true;
+        } while (std::next_permutation(order.begin(), order.end()));
+        return false;
+    };
+    auto check_orientation = [](const std::vector<std::vector<bool>>& adjacent,
+                                const util::csr_graph<double>& oriented) {
+        std::size_t n = adjacent.size();
+        std::vector<std::vector<bool>> arc(n, std::vector<bool>(n, false));
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t j = oriented.offsets[u]; j < oriented.offsets[u + 1]; ++j)
+                arc[u][oriented.targets[j]] = true;
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t v = 0; v < n; ++v) {
+                ASSERT_EQ(adjacent[u][v], arc[u][v] || arc[v][u]);
+                ASSERT_FALSE(arc[u][v] && arc[v][u]);
+                for (std::size_t w = 0; w < n; ++w)
+                    ASSERT_TRUE(!arc[u][v] || !arc[v][w] || arc[u][w]);
+            }
+    };
+
+    // random graphs, with random graphs substituted for some vertices to create modules
+    std::uniform_int_distribution<std::size_t> size_dist(1, 5);
+    std::uniform_real_distribution<double> density(0, 1);
+    for (int i = 0; i < 300; ++i) {
+        std::vector<std::size_t> module_of;
+        std::size_t k = size_dist(engine);
+        for (std::size_t c = 0; c < k && module_of.size() < 9; ++c) {
+            std::size_t size =
+              std::min<std::size_t>(size_dist(engine) % 3 + 1, 9 - module_of.size());
+            module_of.insert(module_of.end(), size, c);
+        }
+        std::size_t n = module_of.size();
+        std::bernoulli_distribution outer(density(engine)), inner(density(engine));
+        std::vector<std::vector<bool>> quotient(k, std::vector<bool>(k, false));
+        for (std::size_t c = 0; c < k; ++c)
+            for (std::size_t d = c + 1; d < k; ++d)
+                quotient[c][d] = quotient[d][c] = outer(engine);
+        std::vector<std::vector<bool>> adjacent(n, std::vector<bool>(n, false));
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t v = u + 1; v < n; ++v)
+                adjacent[u][v] = adjacent[v][u] = module_of[u] == module_of[v]
+                                                    ? inner(engine)
+                                                    : quotient[module_of[u]][module_of[v]];
+        util::csr_graph<double> csr = from_matrix(adjacent);
+
+        // the nodes of the tree are exactly the strong modules
+        graph_alg::modular_decomposition_tree tree = graph_alg::modular_decomposition(csr);
+        std::vector<unsigned> leaves(tree.size(), 0);
+        for (std::size_t v = 0; v < n; ++v)
+            for (std::size_t x = v; x != graph_alg::modular_decomposition_tree::NONE;
+                 x = tree.parent[x])
+                leaves[x] |= 1U << v;
+        ASSERT_NE(tree.root, graph_alg::modular_decomposition_tree::NONE);
+        EXPECT_EQ(leaves[tree.root], (1U << n) - 1);
+        std::vector<unsigned> modules, strong;
+        for (unsigned set = 1; set < 1U << n; ++set)
+            if (is_module(adjacent, set))
+                modules.push_back(set);
+        for (unsigned set : modules) {
+            bool overlaps = false;
+            for (unsigned other : modules)
+                overlaps = overlaps || ((set & other) != 0 && (set & ~other) != 0 &&
+                                        (other & ~set) != 0);
+            if (!overlaps)
+                strong.push_back(set);
+        }
+        std::vector<unsigned> nodes(leaves);
+        std::sort(nodes.begin(), nodes.end());
+        EXPECT_EQ(nodes, strong);
+        for (std::size_t x = n; x < tree.size(); ++x) {
+            EXPECT_GE(tree.children[x].size(), 2);
+            bool joined = connected(adjacent, leaves[x], true);
+            bool co_joined = connected(adjacent, leaves[x], false);
+            if (tree.type[x] == node_type::parallel) {
+                EXPECT_FALSE(joined);
+            } else if (tree.type[x] == node_type::series) {
+                EXPECT_FALSE(co_joined);
+            } else {
+                EXPECT_EQ(tree.type[x], node_type::prime);
+                EXPECT_TRUE(joined && co_joined);
+            }
+        }
+
+        bool comparability = brute_comparability(adjacent);
+        EXPECT_EQ(graph_alg::is_comparability_graph(csr), comparability);
+        if (comparability) {
+            check_orientation(adjacent, graph_alg::transitive_orientation(csr));
+        } else {
+            EXPECT_THROW(graph_alg::transitive_orientation(csr), std::domain_error);
+        }
+    }
+
+    // comparability graphs of random partial orders
+    std::uniform_int_distribution<std::size_t> order_dist(50, 150);
+    for (int i = 0; i < 5; ++i) {
+        std::size_t n = order_dist(engine);
+        std::bernoulli_distribution arc(density(engine) * 4 / n);
+        std::vector<std::vector<bool>> adjacent(n, std::vector<bool>(n, false));
+        for (std::size_t u = n; u-- > 0;)
+            for (std::size_t v = u + 1; v < n; ++v)
+                if (arc(engine)) {
+                    adjacent[u][v] = adjacent[v][u] = true;
+                    for (std::size_t w = v + 1; w < n; ++w)
+                        if (adjacent[v][w])
+                            adjacent[u][w] = adjacent[w][u] = true;
+                }
+        check_orientation(adjacent, graph_alg::transitive_orientation(from_matrix(adjacent)));
+    }
+
+    // threshold graphs, every vertex isolated or dominating those before it: a path of
+    // alternately parallel and series nodes as deep as the graph
+    for (std::size_t n : {200, 2000}) {
+        std::vector<std::vector<bool>> adjacent(n, std::vector<bool>(n, false));
+        for (std::size_t v = 1; v < n; v += 2)
+            for (std::size_t u = 0; u < v; ++u)
+                adjacent[u][v] = adjacent[v][u] = true;
+        util::csr_graph<double> csr = from_matrix(adjacent);
+        graph_alg::modular_decomposition_tree tree = graph_alg::modular_decomposition(csr);
+        ASSERT_EQ(tree.size(), 2 * n - 1);
+        for (std::size_t v = 1; v < n; ++v) {
+            std::size_t node = tree.parent[v];
+            ASSERT_EQ(tree.children[node].size(), 2);
+            EXPECT_EQ(tree.type[node], v % 2 == 1 ? node_type::series : node_type::parallel);
+            EXPECT_EQ(tree.parent[v == 1 ? 0 : tree.parent[v - 1]], node);
+        }
+        EXPECT_EQ(tree.root, tree.parent[n - 1]);
+        EXPECT_TRUE(graph_alg::is_comparability_graph(csr));
+        if (n <= 200)
+            check_orientation(adjacent, graph_alg::transitive_orientation(csr));
+    }
+
+    // odd cycles of length 5 and more are not comparability graphs
+    graph::graph<int, false, false> cycle;
+    for (int v = 0; v < 5; ++v)
+        cycle.add_vertex(v);
+    for (int v = 0; v < 4; ++v)
+        cycle.force_add(v, v + 1);
+    EXPECT_TRUE(graph_alg::is_comparability_graph(cycle));
+    graph::graph<int, true, false> path = graph_alg::transitive_orientation(cycle);
+    for (int v = 1; v < 4; ++v)
+        EXPECT_NE(path.has_edge(v - 1, v), path.has_edge(v, v + 1));
+    cycle.force_add(4, 0);
+    EXPECT_FALSE(graph_alg::is_comparability_graph(cycle));
+    EXPECT_THROW(graph_alg::transitive_orientation(cycle), std::domain_error);
+    EXPECT_EQ(graph_alg::modular_decomposition(cycle).type.back(), node_type::prime);
+}
+
+TEST_F(AlgorithmTest, Two_Dimensional_Orders) {
+    // u < v in both of two random permutations
+    std::uniform_int_distribution<int> size_dist(1, 40);
+    for (int i = 0; i < 20; ++i) {
+        int n = size_dist(engine);
+        std::vector<int> first(n), second(n);
+        std::iota(first.begin(), first.end(), 0);
+        std::iota(second.begin(), second.end(), 0);
+        std::shuffle(first.begin(), first.end(), engine);
+        std::shuffle(second.begin(), second.end(), engine);
+        auto less = [&first, &second](int u, int v) {
+            return first[u] < first[v] && second[u] < second[v];
+        };
+        graph::graph<int, true, false> closure, cover;
+        for (int v = 0; v < n; ++v) {
+            closure.add_vertex(v);
+            cover.add_vertex(v);
+        }
+        for (int u = 0; u < n; ++u)
+            for (int v = 0; v < n; ++v)
+                if (less(u, v)) {
+                    closure.force_add(u, v);
+                    bool covers = true;
+                    for (int w = 0; w < n; ++w)
+                        covers = covers && !(less(u, w) && less(w, v));
+                    if (covers)
+                        cover.force_add(u, v);
+                }
+
+        for (const std::pair<std::list<int>, std::list<int>>& realizer :
+             {graph_alg::two_dimensional_order_generator_closure(closure),
+              graph_alg::two_dimensional_order_generator(cover)}) {
+            ASSERT_EQ(realizer.first.size(), n);
+            ASSERT_EQ(realizer.second.size(), n);
+            std::vector<int> position1(n), position2(n);
+            int p = 0;
+            for (int v : realizer.first)
+                position1[v] = p++;
+            p = 0;
+            for (int v : realizer.second)
+                position2[v] = p++;
+            for (int u = 0; u < n; ++u)
+                for (int v = 0; v < n; ++v)
+                    EXPECT_EQ(less(u, v),
+                              position1[u] < position1[v] && position2[u] < position2[v]);
+        }
+    }
+
+    // a large one, through its closure
+    {
+        int n = 400;
+        std::vector<int> first(n), second(n);
+        std::iota(first.begin(), first.end(), 0);
+        std::iota(second.begin(), second.end(), 0);
+        std::shuffle(first.begin(), first.end(), engine);
+        std::shuffle(second.begin(), second.end(), engine);
+        graph::graph<int, true, false> closure;
+        for (int v = 0; v < n; ++v)
+            closure.add_vertex(v);
+        for (int u = 0; u < n; ++u)
+            for (int v = 0; v < n; ++v)
+                if (first[u] < first[v] && second[u] < second[v])
+                    closure.force_add(u, v);
+        std::pair<std::list<int>, std::list<int>> realizer =
+          graph_alg::two_dimensional_order_generator_closure(closure);
+        std::vector<int> position1(n), position2(n);
+        int p = 0;
+        for (int v : realizer.first)
+            position1[v] = p++;
+        p = 0;
+        for (int v : realizer.second)
+            position2[v] = p++;
+        for (int u = 0; u < n; ++u)
+            for (int v = 0; v < n; ++v)
+                ASSERT_EQ(first[u] < first[v] && second[u] < second[v],
+                          position1[u] < position1[v] && position2[u] < position2[v]);
+    }
+
+    // the standard example S_3, a_i < b_j for i != j, has dimension 3
+    graph::graph<int, true, false> standard;
+    for (int v = 0; v < 6; ++v)
+        standard.add_vertex(v);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            if (i != j)
+                standard.force_add(i, 3 + j);
+    EXPECT_THROW(graph_alg::two_dimensional_order_generator_closure(standard), std::domain_error);
+    EXPECT_THROW(graph_alg::two_dimensional_order_generator(standard), std::domain_error);
+    standard.force_add(4, 0);
+    EXPECT_THROW(graph_alg::two_dimensional_order_generator(standard), std::invalid_argument);
+}
+
+TEST_F(AlgorithmTest, Graph_Coloring) {
+    // proper, and the number of colors used
+    auto check = [](const util::csr_graph<double>& input, const std::vector<std::size_t>& color) {
+        std::size_t used = 0;
+        EXPECT_EQ(color.size(), input.order());
+        for (std::size_t v = 0; v < input.order(); ++v) {
+            used = std::max(used, color[v] + 1);
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                EXPECT_TRUE(input.targets[j] == v || color[input.targets[j]] != color[v]);
+        }
+        return used;
+    };
+
+    std::uniform_int_distribution<std::size_t> size_dist(1, 300);
+    for (int i = 0; i < 30; ++i) {
+        std::size_t n = size_dist(engine);
+        util::csr_graph<double> csr = random_csr(n, size_dist(engine) * 3);
+        std::size_t degree = 0;
+        for (std::size_t v = 0; v < n; ++v)
+            degree = std::max(degree, csr.degree(v));
+        std::vector<std::size_t> core = graph_alg::core_numbers(csr);
+        std::size_t degeneracy = *std::max_element(core.begin(), core.end());
+
+        // every vertex has at most degeneracy neighbors before it
+        std::vector<std::size_t> order = graph_alg::smallest_last_order(csr), position(n);
+        for (std::size_t p = 0; p < n; ++p)
+            position[order[p]] = p;
+        for (std::size_t v = 0; v < n; ++v) {
+            std::size_t earlier = 0;
+            for (std::size_t j = csr.offsets[v]; j < csr.offsets[v + 1]; ++j)
+                earlier += position[csr.targets[j]] < position[v];
+            EXPECT_LE(earlier, degeneracy);
+        }
+        EXPECT_LE(check(csr, graph_alg::smallest_last_coloring(csr)), degeneracy + 1);
+        EXPECT_LE(check(csr, graph_alg::saturation_coloring(csr)), degree + 1);
+
+        std::vector<std::size_t> parallel = graph_alg::Jones_Plassmann_coloring(csr, 4, i);
+        EXPECT_LE(check(csr, parallel), degree + 1);
+        EXPECT_EQ(graph_alg::Jones_Plassmann_coloring(csr, 1, i), parallel);
+
+        // DSATUR is exact on bipartite graphs
+        std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+        std::vector<std::vector<std::size_t>> sides(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            std::size_t u = vertex_dist(engine), v = vertex_dist(engine);
+            if (u % 2 != v % 2) {
+                sides[u].push_back(v);
+                sides[v].push_back(u);
+            }
+        }
+        util::csr_graph<double> bipartite = to_csr(sides);
+        EXPECT_LE(check(bipartite, graph_alg::saturation_coloring(bipartite)), 2);
+    }
+    EXPECT_THROW(graph_alg::greedy_coloring(random_csr(3, 2), {0, 1, 1}),
+                 std::invalid_argument);
+
+    util::csr_graph<double> large = random_csr(200000, 1000000);
+    std::size_t sequential = check(large, graph_alg::smallest_last_coloring(large));
+    EXPECT_LE(check(large, graph_alg::Jones_Plassmann_coloring(large, 4)), 2 * sequential);
+    EXPECT_LE(check(large, graph_alg::saturation_coloring(large)), 2 * sequential);
+
+    graph::graph<int, false, false> cycle;
+    for (int v = 0; v < 6; ++v)
+        cycle.add_vertex(v);
+    for (int v = 0; v < 6; ++v)
+        cycle.force_add(v, (v + 1) % 6);
+    std::unordered_map<int, std::size_t> color = graph_alg::smallest_last_coloring(cycle);
+    for (int v = 0; v < 6; ++v) {
+        EXPECT_LE(color.at(v), 2);
+        EXPECT_NE(color.at(v), color.at((v + 1) % 6));
+    }
+}
+
+TEST_F(AlgorithmTest, Maximum_Clique) {
+    auto gnp_csr = [this](std::size_t n, double p) {
+        std::bernoulli_distribution edge_dist(p);
+        std::vector<std::vector<std::size_t>> adjacency(n);
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t v = u + 1; v < n; ++v)
+                if (edge_dist(engine)) {
+                    adjacency[u].push_back(v);
+                    adjacency[v].push_back(u);
+                }
+        return to_csr(adjacency);
+    };
+    auto is_clique = [](const util::csr_graph<double>& input, const std::vector<std::size_t>& set,
+                        bool independent) {
+        std::vector<bool> in_set(input.order(), false);
+        for (std::size_t v : set)
+            in_set.at(v) = true;
+        for (std::size_t v : set) {
+            std::size_t inside = 0;
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                inside += in_set[input.targets[j]];
+            if (inside != (independent ? 0 : set.size() - 1))
+                return false;
+        }
+        return true;
+    };
+
+    // against every subset
+    std::uniform_int_distribution<std::size_t> size_dist(1, 14);
+    std::uniform_real_distribution<double> density_dist(0.1, 0.9);
+    for (int i = 0; i < 100; ++i) {
+        std::size_t n = size_dist(engine);
+        util::csr_graph<double> csr = gnp_csr(n, density_dist(engine));
+        std::vector<std::uint32_t> adjacency(n, 0);
+        for (std::size_t v = 0; v < n; ++v)
+            for (std::size_t j = csr.offsets[v]; j < csr.offsets[v + 1]; ++j)
+                adjacency[v] |= std::uint32_t(1) << csr.targets[j];
+        std::size_t clique = 0, independent = 0;
+        for (std::uint32_t set = 1; set < (std::uint32_t(1) << n); ++set) {
+            bool all_adjacent = true, none_adjacent = true;
+            for (std::size_t v = 0; v < n; ++v)
+                if ((set >> v & 1) != 0) {
+                    all_adjacent = all_adjacent && (set & ~adjacency[v]) == std::uint32_t(1) << v;
+                    none_adjacent = none_adjacent && (set & adjacency[v]) == 0;
+                }
+            if (all_adjacent)
+                clique = std::max<std::size_t>(clique, std::popcount(set));
+            if (none_adjacent)
+                independent = std::max<std::size_t>(independent, std::popcount(set));
+        }
+
+        std::vector<std::size_t> result = NP_complete::maximum_clique(csr);
+        ASSERT_EQ(result.size(), clique);
+        ASSERT_TRUE(is_clique(csr, result, false));
+        result = NP_complete::maximum_independent_set(csr, 3);
+        ASSERT_EQ(result.size(), independent);
+        ASSERT_TRUE(is_clique(csr, result, true));
+    }
+
+    // beyond one word of bits, on any number of threads
+    for (int i = 0; i < 5; ++i) {
+        util::csr_graph<double> csr = gnp_csr(200, 0.5);
+        std::vector<std::size_t> sequential = NP_complete::maximum_clique(csr);
+        ASSERT_TRUE(is_clique(csr, sequential, false));
+        std::vector<std::size_t> parallel = NP_complete::maximum_clique(csr, 4);
+        ASSERT_TRUE(is_clique(csr, parallel, false));
+        ASSERT_EQ(parallel.size(), sequential.size());
+    }
+
+    // instances, and through Clique_to_Independent_Set
+    for (int j = 0; j < 20; ++j) {
+        graph::graph<int, false, false> input = random_graph<false, false>(engine);
+        std::vector<std::size_t> largest = NP_complete::maximum_clique(util::get_csr_rep(input));
+        for (std::size_t k : {largest.size(), largest.size() + 1}) {
+            auto instance = std::make_pair(input, k);
+            std::list<int> clique = NP_complete::Clique_solver(instance, 2);
+            auto IS_instance = NP_complete::Clique_to_Independent_Set(instance);
+            std::list<int> independent = NP_complete::Independent_Set_solver(IS_instance);
+            if (k > largest.size()) {
+                ASSERT_TRUE(clique.empty());
+                ASSERT_TRUE(independent.empty());
+                continue;
+            }
+            ASSERT_TRUE(
+              NP_complete::cert_clique(instance, std::make_pair(clique.begin(), clique.end())));
+            ASSERT_TRUE(NP_complete::cert_independent_set(
+              IS_instance, std::make_pair(independent.begin(), independent.end())));
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Minimum_Vertex_Cover) {
+    auto is_cover = [](const util::csr_graph<double>& input,
+                       const std::vector<std::size_t>& cover) {
+        std::vector<bool> in_cover(input.order(), false);
+        for (std::size_t v : cover)
+            in_cover.at(v) = true;
+        for (std::size_t v = 0; v < input.order(); ++v)
+            for (std::size_t j = input.offsets[v]; j < input.offsets[v + 1]; ++j)
+                if (!in_cover[v] && !in_cover[input.targets[j]])
+                    return false;
+        return true;
+    };
+
+    // against every subset, with parallel edges and self-loops
+    std::uniform_int_distribution<std::size_t> size_dist(1, 16);
+    for (int i = 0; i < 200; ++i) {
+        std::size_t n = size_dist(engine);
+        util::csr_graph<double> csr = random_csr(n, size_dist(engine) * n / 4);
+        std::vector<std::uint32_t> adjacency(n, 0);
+        for (std::size_t v = 0; v < n; ++v)
+            for (std::size_t j = csr.offsets[v]; j < csr.offsets[v + 1]; ++j)
+                adjacency[v] |= std::uint32_t(1) << csr.targets[j];
+        std::size_t smallest = n;
+        for (std::uint32_t set = 0; set < (std::uint32_t(1) << n); ++set) {
+            bool covers = true;
+            for (std::size_t v = 0; v < n && covers; ++v)
+                covers = (set >> v & 1) != 0 || (adjacency[v] & ~set) == 0;
+            if (covers)
+                smallest = std::min<std::size_t>(smallest, std::popcount(set));
+        }
+
+        std::vector<std::size_t> cover = NP_complete::minimum_vertex_cover(csr, 1 + i % 3);
+        ASSERT_TRUE(is_cover(csr, cover));
+        ASSERT_EQ(cover.size(), smallest);
+    }
+
+    // cycles and paths fold down completely
+    for (std::size_t n = 3; n < 40; ++n) {
+        std::vector<std::vector<std::size_t>> cycle_lists(n), path_lists(n);
+        for (std::size_t v = 0; v < n; ++v) {
+            cycle_lists[v] = {(v + n - 1) % n, (v + 1) % n};
+            if (v > 0)
+                path_lists[v].push_back(v - 1);
+            if (v + 1 < n)
+                path_lists[v].push_back(v + 1);
+        }
+        util::csr_graph<double> cycle = to_csr(cycle_lists), path = to_csr(path_lists);
+        ASSERT_EQ(NP_complete::vertex_cover_kernel(cycle).live().size(), 0);
+        ASSERT_EQ(NP_complete::minimum_vertex_cover(cycle).size(), (n + 1) / 2);
+        ASSERT_EQ(NP_complete::minimum_vertex_cover(path).size(), n / 2);
+    }
+
+    // sparse graphs past the kernel, on any number of threads
+    for (int i = 0; i < 5; ++i) {
+        util::csr_graph<double> csr = random_csr(2000, 3000);
+        std::vector<std::size_t> sequential = NP_complete::minimum_vertex_cover(csr);
+        ASSERT_TRUE(is_cover(csr, sequential));
+        ASSERT_EQ(NP_complete::minimum_vertex_cover(csr, 4).size(), sequential.size());
+    }
+
+    // instances, through Independent_Set_to_Vertex_Cover
+    for (int j = 0; j < 20; ++j) {
+        graph::graph<int, false, false> input = random_graph<false, false>(engine);
+        std::size_t smallest = NP_complete::minimum_vertex_cover(util::get_csr_rep(input)).size();
+        auto instance = NP_complete::Independent_Set_to_Vertex_Cover(
+          std::make_pair(input, input.order() - smallest));
+        std::list<int> cover = NP_complete::Vertex_Cover_solver(instance);
+        ASSERT_TRUE(
+          NP_complete::cert_vertex_cover(instance, std::make_pair(cover.begin(), cover.end())));
+        if (smallest > 0) {
+            --instance.second;
+            ASSERT_TRUE(NP_complete::Vertex_Cover_solver(instance, 2).empty());
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Approximate_Vertex_Cover) {
+    std::uniform_int_distribution<std::size_t> size_dist(1, 2000);
+    std::uniform_real_distribution<double> weight_dist(0, 10);
+    for (int i = 0; i < 20; ++i) {
+        std::size_t n = size_dist(engine);
+        std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+        std::vector<std::pair<std::size_t, std::size_t>> edges;
+        std::vector<std::vector<std::size_t>> adjacency(n);
+        for (std::size_t j = std::min(n, size_dist(engine)); j > 0; --j) {
+            std::size_t u = vertex_dist(engine), v = vertex_dist(engine);
+            edges.emplace_back(u, v);
+            adjacency[u].push_back(v);
+            if (u != v)
+                adjacency[v].push_back(u);
+        }
+        util::csr_graph<double> csr = to_csr(adjacency);
+        std::vector<double> weight(n);
+        for (double& w : weight)
+            w = weight_dist(engine);
+
+        std::size_t smallest = NP_complete::minimum_vertex_cover(csr).size();
+        std::vector<std::vector<std::size_t>> covers = {
+          approx::vertex_cover_maximal_matching(csr),
+          approx::vertex_cover_maximal_matching(n, edges.begin(), edges.end()),
+          approx::weighted_vertex_cover_local_ratio(csr, weight),
+          approx::weighted_vertex_cover_local_ratio(weight, edges.begin(), edges.end())};
+        for (std::size_t c = 0; c < covers.size(); ++c) {
+            std::vector<bool> in_cover(n, false);
+            for (std::size_t v : covers[c])
+                in_cover.at(v) = true;
+            for (const std::pair<std::size_t, std::size_t>& edge : edges)
+                ASSERT_TRUE(in_cover[edge.first] || in_cover[edge.second]);
+            if (c < 2) {
+                ASSERT_LE(covers[c].size(), 2 * smallest);
+            }
+        }
+
+        // within twice the weight of a minimum cardinality cover, at least the weighted optimum
+        double matched = 0;
+        for (std::size_t v : NP_complete::minimum_vertex_cover(csr))
+            matched += weight[v];
+        for (std::size_t c = 2; c < 4; ++c) {
+            double total = 0;
+            for (std::size_t v : covers[c])
+                total += weight[v];
+            ASSERT_LE(total, 2 * matched + 1e-9);
+        }
+    }
+
+    // within twice the minimum weight, found by trying every subset of a small graph
+    std::uniform_int_distribution<std::size_t> small_dist(1, 16);
+    for (int i = 0; i < 50; ++i) {
+        std::size_t n = small_dist(engine);
+        std::uniform_int_distribution<std::size_t> vertex_dist(0, n - 1);
+        std::vector<std::pair<std::size_t, std::size_t>> edges;
+        std::vector<std::vector<std::size_t>> adjacency(n);
+        for (std::size_t j = small_dist(engine) * 2; j > 0; --j) {
+            std::size_t u = vertex_dist(engine), v = vertex_dist(engine);
+            edges.emplace_back(u, v);
+            adjacency[u].push_back(v);
+            if (u != v)
+                adjacency[v].push_back(u);
+        }
+        std::vector<double> weight(n);
+        for (double& w : weight)
+            w = weight_dist(engine);
+
+        double optimum = std::numeric_limits<double>::infinity();
+        for (std::uint32_t set = 0; set < 1U << n; ++set) {
+            bool covers = true;
+            for (const std::pair<std::size_t, std::size_t>& edge : edges)
+                covers = covers && ((set >> edge.first & 1) || (set >> edge.second & 1));
+            if (!covers)
+                continue;
+            double total = 0;
+            for (std::size_t v = 0; v < n; ++v)
+                if (set >> v & 1)
+                    total += weight[v];
+            optimum = std::min(optimum, total);
+        }
+        for (const std::vector<std::size_t>& cover :
+             {approx::weighted_vertex_cover_local_ratio(to_csr(adjacency), weight),
+              approx::weighted_vertex_cover_local_ratio(weight, edges.begin(), edges.end())}) {
+            double total = 0;
+            for (std::size_t v : cover)
+                total += weight[v];
+            ASSERT_GE(total, optimum - 1e-9);
+            ASSERT_LE(total, 2 * optimum + 1e-9);
+        }
+    }
+}
+
+TEST_F(AlgorithmTest, Triangle_Counting) {
+
+    // loops and parallel edges included
+    std::uniform_int_distribution<std::size_t> size_dist(1, 60);
+    for (int i = 0; i < 50; ++i) {
+        std::size_t n = size_dist(engine);
+        util::csr_graph<double> csr = random_csr(n, size_dist(engine) * (i % 10 + 1));
+        std::vector<std::vector<bool>> adjacent(n, std::vector<bool>(n, false));
+        for (std::size_t v = 0; v < n; ++v)
+            for (std::size_t j = csr.offsets[v]; j < csr.offsets[v + 1]; ++j)
+                adjacent[v][csr.targets[j]] = csr.targets[j] != v;
+
+        std::size_t total = 0, paths = 0;
+        std::vector<std::size_t> through(n, 0), degree(n, 0);
+        for (std::size_t u = 0; u < n; ++u)
+            for (std::size_t v = u + 1; v < n; ++v)
+                for (std::size_t w = v + 1; w < n; ++w)
+                    if (adjacent[u][v] && adjacent[v][w] && adjacent[u][w]) {
+                        ++total;
+                        ++through[u], ++through[v], ++through[w];
+                    }
+        for (std::size_t v = 0; v < n; ++v) {
+            degree[v] = std::count(adjacent[v].begin(), adjacent[v].end(), true);
+            paths += degree[v] * (degree[v] - (degree[v] > 0)) / 2;
+        }
+
+        EXPECT_EQ(graph_alg::count_triangles(csr), total);
+        EXPECT_EQ(graph_alg::count_triangles(csr, 4), total);
+        graph_alg::triangle_census census = graph_alg::count_triangles_per_vertex(csr, 3);
+        EXPECT_EQ(census.total, total);
+        EXPECT_EQ(census.per_vertex, through);
+        for (std::size_t v = 0; v < n; ++v)
+            EXPECT_DOUBLE_EQ(census.clustering[v],
+                             degree[v] < 2 ? 0 : 2.0 * through[v] / (degree[v] * (degree[v] - 1)));
+        EXPECT_DOUBLE_EQ(census.transitivity, paths == 0 ? 0 : 3.0 * total / paths);
+    }
+
+    // complete graph: every vertex lies on (n - 1)(n - 2) / 2 triangles
+    std::size_t k = 40;
+    std::vector<std::vector<std::size_t>> adjacency(k);
+    for (std::size_t v = 0; v < k; ++v)
+        for (std::size_t w = 0; w < k; ++w)
+            if (w != v)
+                adjacency[v].push_back(w);
+    util::csr_graph<double> complete = to_csr(adjacency);
+    graph_alg::triangle_census census = graph_alg::count_triangles_per_vertex(complete, 2);
+    EXPECT_EQ(census.total, k * (k - 1) * (k - 2) / 6);
+    EXPECT_EQ(census.per_vertex, std::vector<std::size_t>(k, (k - 1) * (k - 2) / 2));
+    EXPECT_EQ(census.clustering, std::vector<double>(k, 1));
+    EXPECT_DOUBLE_EQ(census.transitivity, 1);
+
+    util::csr_graph<double> large = random_csr(100000, 1000000);
+    std::size_t sequential = graph_alg::count_triangles(large);
+    EXPECT_EQ(graph_alg::count_triangles(large, 4), sequential);
+    EXPECT_EQ(graph_alg::count_triangles_per_vertex(large, 4).total, sequential);
+
+    graph::graph<int, false, false> wheel;
+    for (int v = 0; v <= 6; ++v)
+        wheel.add_vertex(v);
+    for (int v = 1; v <= 6; ++v) {
+        wheel.force_add(0, v);
+        wheel.force_add(v, v % 6 + 1);
+    }
+    EXPECT_EQ(graph_alg::count_triangles(wheel), 6);
+    std::unordered_map<int, double> clustering = graph_alg::clustering_coefficients(wheel);
+    EXPECT_DOUBLE_EQ(clustering.at(0), 6.0 / 15);
+    for (int v = 1; v <= 6; ++v)
+        EXPECT_DOUBLE_EQ(clustering.at(v), 2.0 / 3);
+}
+
+TEST_F(AlgorithmTest, PageRank) {
+    // (I - damping P^T) x = (1 - damping) p by Gaussian elimination, P jumping to p when dangling
+    auto solve = [](const util::csr_graph<double>& csr, const std::vector<double>& p,
+                    double damping) {
+        std::size_t n = csr.order();
+        std::vector<std::vector<double>> a(n, std::vector<double>(n + 1, 0));
+        for (std::size_t v = 0; v < n; ++v) {
+            a[v][v] += 1;
+            a[v][n] = (1 - damping) * p[v];
+        }
+        for (std::size_t u = 0; u < n; ++u) {
+            for (std::size_t j = csr.offsets[u]; j < csr.offsets[u + 1]; ++j)
+                a[csr.targets[j]][u] -= damping / csr.degree(u);
+            if (csr.degree(u) == 0)
+                for (std::size_t v = 0; v < n; ++v)
+                    a[v][u] -= damping * p[v];
+        }
+        for (std::size_t c = 0; c < n; ++c) {
+            std::size_t pivot = c;
+            for (std::size_t r = c + 1; r < n; ++r)
+                if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+                    pivot = r;
+            std::swap(a[c], a[pivot]);
+            for (std::size_t r = 0; r < n; ++r)
+                if (r != c) {
+                    double factor = a[r][c] / a[c][c];
+                    for (std::size_t k = c; k <= n; ++k)
+                        a[r][k] -= factor * a[c][k];
+                }
+        }
+        std::vector<double> x(n);
+        for (std::size_t v = 0; v < n; ++v)
+            x[v] = a[v][n] / a[v][v];
+        return x;
+    };
+    auto distance = [](const std::vector<double>& x, const std::vector<double>& y) {
+        double sum = 0;
+        for (std::size_t v = 0; v < x.size(); ++v)
+            sum += std::abs(x[v] - y[v]);
+        return sum;
+    };
+
+    std::uniform_int_distribution<std::size_t> size_dist(1, 60);
+    for (int i = 0; i < 30; ++i) {
+        std::size_t n = size_dist(engine);
+        util::csr_graph<double> csr = random_csr(n, size_dist(engine) * (i % 4), true);
+        std::vector<std::size_t> seeds;
+        if (i % 2 == 1)
+            for (int k = 0; k < 3; ++k)
+                seeds.push_back(size_dist(engine) % n);
+        std::vector<double> p(n, seeds.empty() ? 1.0 / n : 0);
+        for (std::size_t s : seeds)
+            p[s] += 1.0 / seeds.size();
+        std::vector<double> exact = solve(csr, p, 0.85);
+
+        graph_alg::pagerank_result pull = graph_alg::pagerank(csr, seeds, 0.85, 1e-12, 4);
+        EXPECT_TRUE(pull.converged);
+        EXPECT_LT(distance(pull.rank, exact), 1e-9);
+        EXPECT_EQ(pull.edges_scanned, pull.iterations() * csr.size());
+        EXPECT_LT(distance(graph_alg::pagerank(csr, seeds, 0.85, 1e-12).rank, pull.rank), 1e-12);
+
+        graph_alg::pagerank_result sweep =
+          graph_alg::pagerank_Gauss_Seidel(csr, seeds, 0.85, 1e-12);
+        EXPECT_TRUE(sweep.converged);
+        EXPECT_LT(distance(sweep.rank, exact), 1e-9);
+
+        if (!seeds.empty()) {
+            graph_alg::pagerank_result push =
+              graph_alg::personalized_pagerank(csr, seeds, 0.85, 1e-7);
+            EXPECT_LE(distance(push.rank, exact), push.residuals.back() + 1e-12);
+            EXPECT_LE(push.residuals.back(), 1e-7 * (n + csr.size()));
+            for (std::size_t v = 0; v < n; ++v)
+                EXPECT_LE(push.rank[v], exact[v] + 1e-12);
+        }
+    }
+
+    // residuals of power iteration shrink at least as fast as damping
+    util::csr_graph<double> large = random_csr(100000, 1000000, true);
+    graph_alg::pagerank_result pull = graph_alg::pagerank(large, {}, 0.85, 1e-10, 4);
+    EXPECT_TRUE(pull.converged);
+    for (std::size_t k = 1; k < pull.iterations(); ++k)
+        EXPECT_LE(pull.residuals[k], 0.85 * pull.residuals[k - 1] * (1 + 1e-9));
+    graph_alg::pagerank_result sweep = graph_alg::pagerank_Gauss_Seidel(large, {}, 0.85, 1e-10);
+    EXPECT_LT(distance(sweep.rank, pull.rank), 1e-8);
+    EXPECT_LT(sweep.iterations(), pull.iterations());
+
+    // push from one seed only touches what the mass reaches
+    graph_alg::pagerank_result push = graph_alg::personalized_pagerank(large, {0}, 0.85, 1e-4);
+    EXPECT_LT(push.edges_scanned, large.size() / 10);
+    graph_alg::pagerank_result reference = graph_alg::pagerank(large, {0}, 0.85, 1e-12, 4);
+    EXPECT_LE(distance(push.rank, reference.rank), push.residuals.back() + 1e-9);
+
+    EXPECT_FALSE(graph_alg::pagerank(large, {}, 0.85, 1e-10, 1, 3).converged);
+    EXPECT_THROW(graph_alg::pagerank(large, {}, 1.0), std::invalid_argument);
+    EXPECT_THROW(graph_alg::pagerank(large, {large.order()}), std::invalid_argument);
+    EXPECT_THROW(graph_alg::personalized_pagerank(large, {}), std::invalid_argument);
+
+    // every vertex of a cycle ranks the same; the center of a star ranks highest
+    graph::graph<int, false, false> star;
+    for (int v = 0; v <= 5; ++v)
+        star.add_vertex(v);
+    for (int v = 1; v <= 5; ++v)
+        star.force_add(0, v);
+    std::unordered_map<int, double> rank = graph_alg::pagerank(star);
+    for (int v = 1; v <= 5; ++v) {
+        EXPECT_GT(rank.at(0), rank.at(v));
+        EXPECT_NEAR(rank.at(v), rank.at(1), 1e-12);
+    }
+    EXPECT_NEAR(rank.at(0) + 5 * rank.at(1), 1, 1e-9);
+    std::unordered_map<int, double> personal = graph_alg::pagerank(star, std::vector<int>{3});
+    for (int v : {1, 2, 4, 5})
+        EXPECT_GT(personal.at(3), personal.at(v));
+    EXPECT_GT(personal.at(0), personal.at(3));
+}
+
+TEST_F(AlgorithmTest, Shortest_Path_Centrality) {
+    // distances by Floyd-Warshall, path counts in order of distance from every source
+    auto brute_force = [](const util::csr_graph<double>& csr, bool weighted) {
+        std::size_t n = csr.order();
+        const double INF = std::numeric_limits<double>::infinity();
+        std::vector<std::vector<double>> d(n, std::vector<double>(n, INF));
+        for (std::size_t u = 0; u < n; ++u) {
+            d[u][u] = 0;
+            for (std::size_t j = csr.offsets[u]; j < csr.offsets[u + 1]; ++j)
+                if (csr.targets[j] != u)
+                    d[u][csr.targets[j]] =
+                      std::min(d[u][csr.targets[j]], weighted ? csr.weights[j] : 1);
+        }
+        for (std::size_t k = 0; k < n; ++k)
+            for (std::size_t u = 0; u < n; ++u)
+                for (std::size_t v = 0; v < n; ++v)
+                    d[u][v] = std::min(d[u][v], d[u][k] + d[k][v]);
+
+        std::vector<std::vector<double>> paths(n, std::vector<double>(n, 0));
+        for (std::size_t s = 0; s < n; ++s) {
+            std::vector<std::size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(),
+                      [&](std::size_t u, std::size_t v) { return d[s][u] < d[s][v]; });
+            paths[s][s] = 1;
+            for (std::size_t u : order)
+                for (std::size_t j = csr.offsets[u]; j < csr.offsets[u + 1]; ++j)
+                    if (d[s][u] + (weighted ? csr.weights[j] : 1) == d[s][csr.targets[j]])
+                        paths[s][csr.targets[j]] += paths[s][u];
+        }
+
+        graph_alg::centrality_scores result;
+        result.betweenness.assign(n, 0);
+        result.closeness.assign(n, 0);
+        for (std::size_t s = 0; s < n; ++s) {
+            double sum = 0, reached = 0;
+            for (std::size_t t = 0; t < n; ++t) {
+                if (t != s && d[s][t] != INF) {
+                    sum += d[s][t];
+                    ++reached;
+                }
+                for (std::size_t v = 0; v < n; ++v)
+                    if (v != s && v != t && s != t && d[s][v] + d[v][t] == d[s][t] &&
+                        d[s][t] != INF)
+                        result.betweenness[v] += paths[s][v] * paths[v][t] / paths[s][t];
+            }
+            if (reached > 0)
+                result.closeness[s] = reached / sum * reached / (n - 1);
+        }
+        return result;
+    };
+    auto near = [](const std::vector<double>& x, const std::vector<double>& y) {
+        EXPECT_EQ(x.size(), y.size());
+        for (std::size_t v = 0; v < x.size(); ++v)
+            EXPECT_NEAR(x[v], y[v], 1e-9 * (1 + std::abs(y[v])));
+    };
+
+    // loops and parallel edges included
+    std::uniform_int_distribution<std::size_t> size_dist(1, 40);
+    for (int i = 0; i < 40; ++i) {
+        std::size_t n = size_dist(engine);
+        bool weighted = i % 2 == 0;
+        util::csr_graph<double> csr = random_csr(n, size_dist(engine) * (i % 3 + 1), i % 4 >= 2, 3);
+        graph_alg::centrality_scores expected = brute_force(csr, weighted);
+        graph_alg::centrality_scores scores = graph_alg::shortest_path_centrality(csr, weighted, 3);
+        near(scores.betweenness, expected.betweenness);
+        near(scores.closeness, expected.closeness);
+        EXPECT_EQ(scores.sources, n);
+        EXPECT_EQ(scores.error, 0);
+
+        graph_alg::centrality_scores sampled =
+          graph_alg::sampled_betweenness(csr, n / 2 + 1, weighted, 2, i);
+        for (std::size_t v = 0; v < n; ++v)
+            EXPECT_LE(std::abs(sampled.betweenness[v] - expected.betweenness[v]),
+                      sampled.error + 1e-9);
+    }
+
+    util::csr_graph<double> large = random_csr(3000, 9000, false, 3);
+    graph_alg::centrality_scores exact = graph_alg::shortest_path_centrality(large, false, 4);
+    near(graph_alg::shortest_path_centrality(large).betweenness, exact.betweenness);
+    graph_alg::centrality_scores sampled = graph_alg::sampled_betweenness(large, 300, false, 4, 7);
+    EXPECT_EQ(sampled.sources, 300);
+    near(graph_alg::sampled_betweenness(large, 300, false, 1, 7).betweenness,
+         sampled.betweenness);
+    // unbiased: the totals agree much more closely than the single vertices
+    double total = 0, estimated = 0, deviation = 0;
+    for (std::size_t v = 0; v < large.order(); ++v) {
+        total += exact.betweenness[v];
+        estimated += sampled.betweenness[v];
+        deviation += std::abs(sampled.betweenness[v] - exact.betweenness[v]);
+        EXPECT_LE(std::abs(sampled.betweenness[v] - exact.betweenness[v]), sampled.error);
+    }
+    EXPECT_LT(std::abs(estimated - total), 0.05 * total);
+    EXPECT_LT(deviation, 0.5 * total);
+
+    util::csr_graph<double> negative = random_csr(5, 10, true, 3);
+    negative.weights[0] = 0;
+    EXPECT_THROW(graph_alg::shortest_path_centrality(negative, true), std::invalid_argument);
+    EXPECT_THROW(graph_alg::sampled_betweenness(large, 0), std::invalid_argument);
+
+    // path 0 - 1 - 2 - 3 - 4
+    graph::graph<int, false, false> path;
+    for (int v = 0; v < 5; ++v)
+        path.add_vertex(v);
+    for (int v = 0; v < 4; ++v)
+        path.force_add(v, v + 1);
+    std::unordered_map<int, double> betweenness = graph_alg::betweenness_centrality(path, 2);
+    std::unordered_map<int, double> closeness = graph_alg::closeness_centrality(path);
+    EXPECT_DOUBLE_EQ(betweenness.at(0), 0);
+    EXPECT_DOUBLE_EQ(betweenness.at(1), 3);
+    EXPECT_DOUBLE_EQ(betweenness.at(2), 4);
+    EXPECT_DOUBLE_EQ(closeness.at(0), 0.4);
+    EXPECT_DOUBLE_EQ(closeness.at(2), 4.0 / 6);
+}
+
 TEST_F(AlgorithmTest, FFT) {
     std::array<std::complex<double>, 16> roots_of_unity;
     for (int i = 0; i < 16; ++i) {
@@ -663,3 +2719,47 @@ TEST_F(AlgorithmTest, Transitive_Closure_Test) {
         }
     }
 }
+
+TEST_F(AlgorithmTest, Graph_Sanitize) {
+    std::uniform_int_distribution<int> size_dist(1, 60);
+    for (int i = 0; i < 20; ++i) {
+        int n = size_dist(engine);
+        std::uniform_int_distribution<int> vertex_dist(0, n - 1);
+        graph::graph<int, false, false> undirected;
+        graph::graph<int, true, false> directed;
+        for (int v = 0; v < n; ++v) {
+            undirected.add_vertex(v);
+            directed.add_vertex(v);
+        }
+
+        // every edge added up to three times
+        std::vector<std::set<int>> expected_undirected(n), expected_directed(n);
+        for (int k = 0; k < 4 * n; ++k) {
+            int u = vertex_dist(engine), v = vertex_dist(engine);
+            if (u == v)
+                continue;
+            for (int copies = k % 3; copies >= 0; --copies) {
+                undirected.force_add(u, v);
+                directed.force_add(u, v);
+            }
+            expected_undirected[u].insert(v);
+            expected_undirected[v].insert(u);
+            expected_directed[u].insert(v);
+        }
+
+        for (int round = 0; round < 2; ++round) {
+            undirected.sanitize();
+            directed.sanitize();
+            for (int v = 0; v < n; ++v) {
+                std::list<int> neighbors = undirected.neighbors(v);
+                EXPECT_EQ(neighbors.size(), expected_undirected[v].size());
+                EXPECT_EQ(std::set<int>(neighbors.begin(), neighbors.end()),
+                          expected_undirected[v]);
+                neighbors = directed.neighbors(v);
+                EXPECT_EQ(neighbors.size(), expected_directed[v].size());
+                EXPECT_EQ(std::set<int>(neighbors.begin(), neighbors.end()),
+                          expected_directed[v]);
+            }
+        }
+    }
+}
@@ -37,6 +37,95 @@ namespace util {
                 output[i][ptr->first] = std::make_pair(true, ptr);
         return output;
     }
+
+    /*
+     * Compressed sparse row copy of a graph, numbered as in src.get_translation()
+     * The edges out of vertex i are (targets[j], weights[j]) for offsets[i] <= j < offsets[i + 1]
+     * Undirected edges are stored once in each direction
+     */
+    template <typename EdgeWeight>
+    struct csr_graph {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> targets;
+        std::vector<EdgeWeight> weights;
+
+        std::size_t order() const noexcept { return offsets.empty() ? 0 : offsets.size() - 1; }
+        std::size_t size() const noexcept { return targets.size(); }
+        std::size_t degree(std::size_t v) const noexcept { return offsets[v + 1] - offsets[v]; }
+    };
+
+    template <typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
+    csr_graph<EdgeWeight> get_csr_rep(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& src) {
+        csr_graph<EdgeWeight> output;
+        std::vector<Vertex> input_vertices = src.vertices();
+        output.offsets.reserve(input_vertices.size() + 1);
+        output.offsets.push_back(0);
+
+        for (const Vertex& v : input_vertices) {
+            for (const std::pair<Vertex, EdgeWeight>& e : src.edges(v)) {
+                output.targets.push_back(src.get_translation().at(e.first));
+                output.weights.push_back(e.second);
+            }
+            output.offsets.push_back(output.targets.size());
+        }
+
+        return output;
+    }
+
+    /*
+     * Reverse (transpose) of a CSR graph; weights follow their edges
+     */
+    template <typename EdgeWeight>
+    csr_graph<EdgeWeight> transpose(const csr_graph<EdgeWeight>& src) {
+        csr_graph<EdgeWeight> output;
+        output.offsets.assign(src.order() + 1, 0);
+        output.targets.resize(src.size());
+        output.weights.resize(src.size());
+
+        for (std::size_t target : src.targets)
+            ++output.offsets[target + 1];
+        for (std::size_t i = 0; i < src.order(); ++i)
+            output.offsets[i + 1] += output.offsets[i];
+
+        std::vector<std::size_t> position(output.offsets.begin(), output.offsets.end() - 1);
+        for (std::size_t v = 0; v < src.order(); ++v)
+            for (std::size_t j = src.offsets[v]; j < src.offsets[v + 1]; ++j) {
+                std::size_t slot = position[src.targets[j]]++;
+                output.targets[slot] = v;
+                output.weights[slot] = src.weights[j];
+            }
+
+        return output;
+    }
+
+    /*
+     * Edge array copy of a graph, numbered as in src.get_translation()
+     * Undirected edges are stored once, with start <= terminal
+     */
+    template <typename EdgeWeight>
+    struct edge_array {
+        std::vector<std::pair<std::size_t, std::size_t>> endpoints;
+        std::vector<EdgeWeight> weights;
+
+        std::size_t size() const noexcept { return endpoints.size(); }
+    };
+
+    template <typename Vertex, bool Directed, bool Weighted, typename EdgeWeight, typename... Args>
+    edge_array<EdgeWeight> get_edge_array(const graph::graph<Vertex, Directed, Weighted, EdgeWeight, Args...>& src) {
+        edge_array<EdgeWeight> output;
+        std::vector<Vertex> input_vertices = src.vertices();
+
+        for (std::size_t i = 0; i < input_vertices.size(); ++i)
+            for (const std::pair<Vertex, EdgeWeight>& e : src.edges(input_vertices[i])) {
+                std::size_t j = src.get_translation().at(e.first);
+                if (Directed || i <= j) {
+                    output.endpoints.emplace_back(i, j);
+                    output.weights.push_back(e.second);
+                }
+            }
+
+        return output;
+    }
 }
 
 #endif // UTIL_EXPOSED_GRAPH_H
@@ -0,0 +1,134 @@
+#ifndef UTIL_PARALLEL_H
+#define UTIL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace util {
+    /*
+     * Resolve a requested thread count: 0 means "use every hardware thread"
+     */
+    inline unsigned thread_count(unsigned requested) {
+        if (requested != 0)
+            return requested;
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    /*
+     * Run f(thread_index) on num_threads threads (the calling thread is thread 0)
+     * Rethrows the first exception raised by any of the workers after all have joined
+     */
+    template<typename F> void parallel_run(unsigned num_threads, F f) {
+        num_threads = thread_count(num_threads);
+        if (num_threads == 1) {
+            f(0U);
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(num_threads);
+        std::vector<std::thread> workers;
+        workers.reserve(num_threads - 1);
+        for (unsigned i = 1; i < num_threads; ++i)
+            workers.emplace_back([&f, &errors, i]() {
+                try {
+                    f(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+
+        try {
+            f(0U);
+        } catch (...) {
+            errors[0] = std::current_exception();
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+
+        for (const std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    /*
+     * Static scheduling: split [first, last) into one contiguous block per thread and run
+     * f(thread_index, block_begin, block_end) on each block
+     */
+    template<typename F>
+    void parallel_blocks(std::size_t first, std::size_t last, unsigned num_threads, F f) {
+        if (first >= last)
+            return;
+        num_threads = static_cast<unsigned>(
+          std::min<std::size_t>(thread_count(num_threads), last - first));
+        std::size_t block = (last - first + num_threads - 1) / num_threads;
+        parallel_run(num_threads, [first, last, block, &f](unsigned id) {
+            std::size_t begin = first + id * block;
+            std::size_t end = std::min(last, begin + block);
+            if (begin < end)
+                f(id, begin, end);
+        });
+    }
+
+    /*
+     * Dynamic scheduling: threads repeatedly claim chunks of grain indices from [first, last)
+     * and run f(thread_index, i) on each claimed index
+     * Preferred when the cost per index varies widely
+     */
+    template<typename F>
+    void parallel_for(std::size_t first, std::size_t last, unsigned num_threads, F f,
+                      std::size_t grain = 1) {
+        if (first >= last)
+            return;
+        grain = std::max<std::size_t>(grain, 1);
+        num_threads = static_cast<unsigned>(std::min<std::size_t>(
+          thread_count(num_threads), (last - first + grain - 1) / grain));
+        std::atomic<std::size_t> next(first);
+        parallel_run(num_threads, [last, grain, &next, &f](unsigned id) {
+            for (std::size_t begin = next.fetch_add(grain); begin < last;
+                 begin = next.fetch_add(grain))
+                for (std::size_t i = begin; i < std::min(last, begin + grain); ++i)
+                    f(id, i);
+        });
+    }
+
+    /*
+     * Sort [first, last) on num_threads threads: blocks are sorted concurrently, then merged
+     * pairwise (the final merge is sequential)
+     */
+    template<typename RandomIt, typename Compare>
+    void parallel_sort(RandomIt first, RandomIt last, unsigned num_threads, Compare comp) {
+        const std::size_t MIN_BLOCK = 4096;
+        std::size_t n = last - first;
+        unsigned threads = static_cast<unsigned>(std::min<std::size_t>(
+          thread_count(num_threads), std::max<std::size_t>(n / MIN_BLOCK, 1)));
+        if (threads == 1) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        std::vector<std::size_t> bounds(threads + 1);
+        for (unsigned i = 0; i <= threads; ++i)
+            bounds[i] = n * i / threads;
+        parallel_run(threads, [first, &bounds, &comp](unsigned id) {
+            std::sort(first + bounds[id], first + bounds[id + 1], comp);
+        });
+
+        for (std::size_t width = 1; width < threads; width *= 2) {
+            std::size_t merges = (threads + 2 * width - 1) / (2 * width);
+            parallel_for(0, merges, threads, [&](unsigned, std::size_t k) {
+                std::size_t low = 2 * width * k;
+                std::size_t middle = std::min<std::size_t>(low + width, threads);
+                std::size_t high = std::min<std::size_t>(low + 2 * width, threads);
+                if (middle < high)
+                    std::inplace_merge(first + bounds[low], first + bounds[middle],
+                                       first + bounds[high], comp);
+            });
+        }
+    }
+} // namespace util
+
+#endif // UTIL_PARALLEL_H